@@ -1,1321 +1,128 @@
-// Generated by Keyframe Editor (https://github.com/adamkohazi/demo-sk8)
+// Generated by Keyframe Reducer (https://github.com/adamkohazi/demo-sk8), max error 0.001
 #ifndef KEYFRAME_DATA_H_
 #define KEYFRAME_DATA_H_
 
-const float timestamps[] = {
-	0.0f,
-	10.0f,
-	18.1953125f,
-	20.6953125f,
-	20.8984375f,
-	21.296875f,
-	26.09375f,
-	26.3984375f,
-	26.6953125f,
-	28.0f,
-	30.59375f,
-	31.59375f,
-	31.8984375f,
-	34.5f,
-	36.0f,
-	36.296875f,
-	36.796875f,
-	37.0f,
-	37.296875f,
-	38.0f,
-	39.0f,
-	39.796875f,
-	41.0f,
-	41.59375f,
-	42.0f,
-	42.296875f,
-	45.296875f,
-	48.296875f,
-	48.59375f,
-	49.09375f,
-	49.296875f,
-	49.59375f,
-	50.59375f,
-	51.890625f,
-	52.890625f,
-	53.1875f,
-	57.1875f,
-	58.1875f,
-	59.1875f,
-	61.5f,
-	61.796875f,
-	70.0f,
-	70.09375f,
-	77.0f,
-};
-
-const float camera_x[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.1992187649011612f,
-	0.1992187798023224f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	-0.5976563692092896f,
-	-0.5976563096046448f,
-	-0.5976563096046448f,
-	-0.5976563096046448f,
-	-0.5976563096046448f,
-	2.802596928649634e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.3984375298023224f,
-	0.5976563096046448f,
-	0.5976563096046448f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.1992187649011612f,
-	5.605193857299268e-45f,
-	0.19921880960464478f,
-	0.1992187649011612f,
-	0.3984375298023224f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	-0.3984375298023224f,
-	-0.0996093899011612f,
-	1.401298464324817e-45f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	-1.0000004768371582f,
-	-1.0000001192092896f,
-	0.39843761920928955f,
-};
-
-const float camera_y[] = {
-	0.5000000596046448f,
-	0.049804698675870895f,
-	0.0498046912252903f,
-	0.0996093899011612f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.3984375596046448f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.1992187798023224f,
-	0.2988281548023224f,
-	0.5000000596046448f,
-	0.5000000596046448f,
-	0.5000000596046448f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.2988281548023224f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	0.5000002384185791f,
-	0.5000000596046448f,
-	0.19921880960464478f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.0996093899011612f,
-	0.0996093824505806f,
-	0.5000000596046448f,
-	0.5000000596046448f,
-	0.5000000596046448f,
-	0.2988281548023224f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-};
-
-const float camera_z[] = {
-	-0.5000000596046448f,
-	1.401298464324817e-45f,
-	0.3984375298023224f,
-	1.000000238418579f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.000000238418579f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	0.7968751192092896f,
-	0.7968750596046448f,
-	0.7968750596046448f,
-	0.7968750596046448f,
-	0.7968750596046448f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	0.7968750596046448f,
-	0.7968750596046448f,
-	0.7968750596046448f,
-	0.7968750596046448f,
-	0.8984375596046448f,
-	0.8984375596046448f,
-	1.0937501192092896f,
-	1.0937501192092896f,
-	1.0937501192092896f,
-	1.0937501192092896f,
-	1.0937501192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0937501192092896f,
-	0.8984375596046448f,
-	0.5976563692092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	1.0000001192092896f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-};
-
-const float target_x[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-1.0000004768371582f,
-	-1.0000001192092896f,
-	0.39843761920928955f,
-};
-
-const float target_y[] = {
-	1.401298464324817e-45f,
-	0.0498046912252903f,
-	0.0498046912252903f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.2988281548023224f,
-	0.5000002384185791f,
-	0.39843761920928955f,
-	0.29882824420928955f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	0.09960940480232239f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-};
-
-const float target_z[] = {
-	-0.5976563096046448f,
-	-0.5976563096046448f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-1.0000001192092896f,
-	-1.0000001192092896f,
-	-1.0000001192092896f,
-};
-
-const float speed[] = {
-	3.0f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	0.5000001192092896f,
-	0.5000001192092896f,
-	1.000000238418579f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	0.5000001192092896f,
-	0.5000001192092896f,
-	0.5000001192092896f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	3.000000476837158f,
-	0.5000001192092896f,
-	0.5000001192092896f,
-	0.5000001192092896f,
-	0.5000001192092896f,
-	0.5000001192092896f,
-	3.000000476837158f,
-	2.802596928649634e-45f,
-	2.802596928649634e-45f,
-	2.802596928649634e-45f,
-};
-
-const float boardEuler_x[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.5000000596046448f,
-	5.500000476837158f,
-	6.875000476837158f,
-	6.281251430511475f,
-	0.0f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.1992187649011612f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	4.203895392974451e-45f,
-	0.0f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	1.401298464324817e-45f,
-	0.3984375298023224f,
-	4.500000476837158f,
-	5.500000476837158f,
-	8.062500953674316f,
-	13.187500953674316f,
-	12.56250286102295f,
-	0.0f,
-	1.401298464324817e-45f,
-	20.0000057220459f,
-};
-
-const float boardEuler_y[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.8984375596046448f,
-	-2.296875238418579f,
-	-5.500000476837158f,
-	-8.687500953674316f,
-	-9.375000953674316f,
-	0.0f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.5000000596046448f,
-	4.500000476837158f,
-	5.687500476837158f,
-	6.093750476837158f,
-	6.281250476837158f,
-	6.281250476837158f,
-	0.0f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float boardEuler_z[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.7968750596046448f,
-	-0.09960939735174179f,
-	-0.09960939735174179f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.1992187798023224f,
-	0.09960939735174179f,
-	0.19921880960464478f,
-	0.09960939735174179f,
-	0.0996093824505806f,
-	-0.2988281548023224f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.7968750596046448f,
-	-0.3984375298023224f,
-	-0.3984375298023224f,
-	-0.1992187649011612f,
-	0.2988281548023224f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	1.5937501192092896f,
-	1.5937501192092896f,
-};
-
-const float boardPos_x[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	-0.1992187649011612f,
-	0.19921879470348358f,
-	1.401298464324817e-45f,
-	-0.19921879470348358f,
-	0.19921879470348358f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	0.0996093824505806f,
-	-0.1992187649011612f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	-0.0996093824505806f,
-	0.29882821440696716f,
-	1.401298464324817e-45f,
-	-0.09960939735174179f,
-	-0.09960939735174179f,
-	-0.09960939735174179f,
-	-0.09960939735174179f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	-0.1992187649011612f,
-	0.19921879470348358f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.5000001192092896f,
-	0.2988281548023224f,
-	0.2988281548023224f,
-};
-
-const float boardPos_y[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.1992187798023224f,
-	0.5000001788139343f,
-	0.1992187798023224f,
-	4.203895392974451e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.039794936776161194f,
-	0.019897466525435448f,
-	0.039794936776161194f,
-	0.019897466525435448f,
-	0.01989746280014515f,
-	0.0996093824505806f,
-	0.29882821440696716f,
-	0.1992187798023224f,
-	4.203895392974451e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	1.401298464324817e-45f,
-	0.1992187798023224f,
-	0.29882821440696716f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	0.3085937798023224f,
-	0.3085937798023224f,
-};
-
-const float boardPos_z[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	-1.0000001192092896f,
-	-1.0000001192092896f,
-};
-
-const float body_twist[] = {
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.2988281846046448f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	-0.2988281846046448f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.1992187649011612f,
-	-0.1992187649011612f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.2988281846046448f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.5000000596046448f,
-	-0.5000000596046448f,
-};
-
-const float bodyHipPosition_x[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	0.0498046949505806f,
-	-0.19921879470348358f,
-	0.29882821440696716f,
-	0.0498046912252903f,
-	-0.19921879470348358f,
-	0.29882821440696716f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	-0.2988281548023224f,
-	1.401298464324817e-45f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	-0.09960939735174179f,
-	0.39843758940696716f,
-	1.401298464324817e-45f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	0.2500000298023224f,
-	0.2500000298023224f,
-	0.2500000298023224f,
-	0.2500000298023224f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	-0.19921879470348358f,
-	0.29882821440696716f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.5000001192092896f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float bodyHipPosition_y[] = {
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	-0.019897466525435448f,
-	-0.0397949256002903f,
-	-0.1894531399011612f,
-	-0.039794933050870895f,
-	-0.039794933050870895f,
-	-0.1992187649011612f,
-	-0.029907232150435448f,
-	-0.019897466525435448f,
-	-0.019897466525435448f,
-	-0.30859386920928955f,
-	2.802596928649634e-45f,
-	0.39843758940696716f,
-	0.0996093899011612f,
-	-0.019897466525435448f,
-	-0.0397949256002903f,
-	-0.1992187649011612f,
-	-0.039794933050870895f,
-	-0.019897466525435448f,
-	-0.0795898512005806f,
-	-0.0795898512005806f,
-	-0.0795898512005806f,
-	-0.0795898512005806f,
-	-0.09960939735174179f,
-	4.203895392974451e-45f,
-	0.29882821440696716f,
-	2.802596928649634e-45f,
-	-0.019897468388080597f,
-	-0.0397949256002903f,
-	-0.1992187649011612f,
-	-0.039794933050870895f,
-	-0.019897466525435448f,
-	-0.019897466525435448f,
-	-0.30859386920928955f,
-	2.802596928649634e-45f,
-	0.2988281548023224f,
-	0.2988281548023224f,
-	0.2988281846046448f,
-	2.802596928649634e-45f,
-	-0.019897466525435448f,
-	-0.019897466525435448f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-};
-
-const float bodyHipPosition_z[] = {
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.1992187649011612f,
-	1.401298464324817e-45f,
-	-0.2988281548023224f,
-	-0.1992187649011612f,
-	-0.1992187649011612f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-1.0000001192092896f,
-	-1.0000001192092896f,
-};
-
-const float hip_rotation_r[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.6992188096046448f,
-	0.6992188096046448f,
-	1.401298464324817e-45f,
-	-0.2988281548023224f,
-	0.2988281548023224f,
-	1.401298464324817e-45f,
-	0.6992188096046448f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.6992188096046448f,
-	0.29882821440696716f,
-	0.19921879470348358f,
-	0.29882821440696716f,
-	0.19921879470348358f,
-	0.1992187649011612f,
-	0.6992188096046448f,
-	1.0937501192092896f,
-	0.7968750596046448f,
-	1.401298464324817e-45f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.6992189288139343f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.5000000596046448f,
-	0.5976563096046448f,
-	0.5976563096046448f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float hip_flexion_r[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.29882821440696716f,
-	0.0996093824505806f,
-	-0.5000000596046448f,
-	0.29882824420928955f,
-	0.0996093824505806f,
-	-0.5000000596046448f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.42968758940696716f,
-	-0.0996093899011612f,
-	0.09960939735174179f,
-	0.5000001192092896f,
-	1.401298464324817e-45f,
-	0.2988281846046448f,
-	0.0996093824505806f,
-	-0.5000000596046448f,
-	1.401298464324817e-45f,
-	0.19921879470348358f,
-	0.19921879470348358f,
-	0.19921879470348358f,
-	0.19921879470348358f,
-	0.1992187649011612f,
-	0.2988281548023224f,
-	0.29882821440696716f,
-	0.2988281846046448f,
-	0.09960940480232239f,
-	0.2988281846046448f,
-	0.0996093824505806f,
-	-0.5000000596046448f,
-	0.0996093824505806f,
-	4.203895392974451e-45f,
-	0.42968758940696716f,
-	-0.0996093899011612f,
-	0.19921880960464478f,
-	0.0996093899011612f,
-	0.1992187649011612f,
-	0.3984375596046448f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float hip_abduction_r[] = {
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.1992187649011612f,
-	0.3984375298023224f,
-	0.1992187649011612f,
-	0.3984375298023224f,
-	0.1992187649011612f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.3984375298023224f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.29882821440696716f,
-	0.2988281548023224f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float knee_flexion_r[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	2.802596928649634e-45f,
-	0.5000000596046448f,
-	0.3984375298023224f,
-	1.401298464324817e-45f,
-	0.5000000596046448f,
-	0.2988281548023224f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.7968751788139343f,
-	0.0996093899011612f,
-	0.5976564288139343f,
-	0.6992188692092896f,
-	1.401298464324817e-45f,
-	2.802596928649634e-45f,
-	0.5000000596046448f,
-	0.2988281548023224f,
-	1.401298464324817e-45f,
-	0.5000001788139343f,
-	0.5000001788139343f,
-	0.5000001788139343f,
-	0.5000001788139343f,
-	0.5000000596046448f,
-	0.2988281548023224f,
-	0.5976564288139343f,
-	0.6992188692092896f,
-	0.19921880960464478f,
-	2.802596928649634e-45f,
-	0.5000000596046448f,
-	0.2988281548023224f,
-	0.1992187798023224f,
-	4.203895392974451e-45f,
-	0.7968751788139343f,
-	0.0996093899011612f,
-	0.5976564884185791f,
-	0.6992188692092896f,
-	0.7968750596046448f,
-	0.7968751192092896f,
-	4.203895392974451e-45f,
-	4.203895392974451e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float ankle_flexion_r[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.5976563096046448f,
-	0.8984375596046448f,
-	0.0996093824505806f,
-	-0.5976563096046448f,
-	0.8984375596046448f,
-	-0.5976563096046448f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.0000003576278687f,
-	-1.000000238418579f,
-	-0.5000001788139343f,
-	0.0996093824505806f,
-	4.203895392974451e-45f,
-	-0.5976563692092896f,
-	0.8984375596046448f,
-	-0.5976563096046448f,
-	1.401298464324817e-45f,
-	0.7968751788139343f,
-	0.5976564288139343f,
-	0.7968751788139343f,
-	0.5976564288139343f,
-	0.6992188096046448f,
-	0.8984375596046448f,
-	0.3984375298023224f,
-	0.0996093899011612f,
-	0.09960939735174179f,
-	-0.5976563692092896f,
-	0.8984375596046448f,
-	-0.5976563096046448f,
-	0.09960939735174179f,
-	-0.09960939735174179f,
-	1.0000003576278687f,
-	-0.3984375596046448f,
-	5.605193857299268e-45f,
-	2.802596928649634e-45f,
-	1.401298464324817e-45f,
-	0.3984375596046448f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float hip_rotation_l[] = {
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.5000000596046448f,
-	-0.5000000596046448f,
-	0.0996093824505806f,
-	1.0000001192092896f,
-	0.5976563096046448f,
-	0.2988281548023224f,
-	-0.5000000596046448f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.5000000596046448f,
-	-0.5000000596046448f,
-	-0.8984375596046448f,
-	-0.5000000596046448f,
-	-0.8984375596046448f,
-	-0.5000000596046448f,
-	-1.0937501192092896f,
-	-0.7968750596046448f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.2988281548023224f,
-	-0.5000000596046448f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float hip_flexion_l[] = {
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.09960939735174179f,
-	0.29882821440696716f,
-	0.09960939735174179f,
-	0.09960939735174179f,
-	0.29882821440696716f,
-	0.09960939735174179f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.39843758940696716f,
-	0.5000002384185791f,
-	0.39843758940696716f,
-	0.3984375596046448f,
-	0.0996093824505806f,
-	0.09960939735174179f,
-	0.29882821440696716f,
-	0.09960939735174179f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	0.39843758940696716f,
-	0.3984375596046448f,
-	0.0996093824505806f,
-	0.09960939735174179f,
-	0.29882821440696716f,
-	0.09960939735174179f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.39843758940696716f,
-	0.5000002384185791f,
-	0.39843761920928955f,
-	0.1992187798023224f,
-	-0.19921879470348358f,
-	0.39843761920928955f,
-	0.09960939735174179f,
-	0.19921879470348358f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float hip_abduction_l[] = {
-	0.1992187649011612f,
-	0.1992187649011612f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.8984375596046448f,
-	0.5000000596046448f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	0.0996093824505806f,
-	0.0996093899011612f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	-0.6992188096046448f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-	-0.0996093824505806f,
-	-0.0996093824505806f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	0.3984375298023224f,
-	0.2988281548023224f,
-	0.2988281548023224f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float knee_flexion_l[] = {
-	0.19921880960464478f,
-	0.19921880960464478f,
-	0.19921880960464478f,
-	0.19921879470348358f,
-	0.5976563096046448f,
-	0.1992187649011612f,
-	0.19921879470348358f,
-	0.5976563096046448f,
-	0.19921879470348358f,
-	0.09960940480232239f,
-	0.19921880960464478f,
-	0.7968752384185791f,
-	0.8984377384185791f,
-	0.39843758940696716f,
-	0.7968751192092896f,
-	0.09960939735174179f,
-	0.19921879470348358f,
-	0.5976563096046448f,
-	0.1992187649011612f,
-	0.09960940480232239f,
-	0.39843758940696716f,
-	0.3984375298023224f,
-	0.39843758940696716f,
-	0.3984375298023224f,
-	0.5000002384185791f,
-	0.29882824420928955f,
-	0.5976564288139343f,
-	0.6992188692092896f,
-	0.1992187649011612f,
-	0.19921879470348358f,
-	0.5976563096046448f,
-	0.1992187649011612f,
-	0.0996093824505806f,
-	0.1992187649011612f,
-	0.7968752384185791f,
-	0.8984377384185791f,
-	0.09960940480232239f,
-	0.5000001192092896f,
-	0.09960939735174179f,
-	0.6992189884185791f,
-	0.19921879470348358f,
-	0.09960939735174179f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
-};
-
-const float ankle_flexion_l[] = {
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.0996093824505806f,
-	0.29882821440696716f,
-	0.8984377384185791f,
-	0.2988281548023224f,
-	0.29882821440696716f,
-	1.0000001192092896f,
-	0.29882821440696716f,
-	-0.0996093824505806f,
-	0.1992187649011612f,
-	1.0937504768371582f,
-	5.605193857299268e-45f,
-	-0.29882821440696716f,
-	0.6992188096046448f,
-	-0.0996093824505806f,
-	0.29882821440696716f,
-	1.0000004768371582f,
-	0.2988281548023224f,
-	-0.0996093824505806f,
-	0.39843758940696716f,
-	0.3984375298023224f,
-	0.39843758940696716f,
-	0.3984375298023224f,
-	0.5976563096046448f,
-	-1.0000001192092896f,
-	1.401298464324817e-45f,
-	0.5000001192092896f,
-	0.09960939735174179f,
-	0.29882821440696716f,
-	1.0000004768371582f,
-	0.2988281548023224f,
-	-0.09960939735174179f,
-	0.09960939735174179f,
-	1.0937504768371582f,
-	5.605193857299268e-45f,
-	5.605193857299268e-45f,
-	-0.0996093899011612f,
-	-0.5000001788139343f,
-	-0.3984375596046448f,
-	0.09960939735174179f,
-	0.19921879470348358f,
-	1.401298464324817e-45f,
-	1.401298464324817e-45f,
+// Keys of every track back to back, in the order of the Track enum, timed by an index into the shared timestamps
+#define SPARSE_KEYFRAMES
+
+constexpr unsigned short trackKeyCounts[] = { 33, 33, 23, 19, 25, 5, 15, 22, 16, 24, 32, 25, 17, 30, 34, 40, 28, 32, 36, 24, 36, 39, 29, 36, 36, 39, 40 };
+
+constexpr float sharedKeyTimes[] = {
+	0.0f, 10.0f, 18.1953125f, 20.6953125f, 20.8984375f, 21.296875f, 26.09375f, 26.3984375f, 26.6953125f, 28.0f, 30.59375f, 31.59375f, 31.8984375f, 34.5f, 36.0f, 36.296875f, 36.796875f, 37.0f, 37.296875f, 38.0f, 39.0f, 39.796875f, 41.0f, 41.59375f, 42.0f, 42.296875f, 45.296875f, 48.296875f, 48.59375f, 49.09375f, 49.296875f, 49.59375f, 50.59375f, 51.890625f, 52.890625f, 53.1875f, 57.1875f, 58.1875f, 59.1875f, 61.5f, 61.796875f, 70.0f, 70.09375f, 77.0f,
+};
+
+constexpr unsigned char trackKeyTimes[] = {
+	// camera_x
+	0, 1, 2, 3, 5, 6, 10, 11, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 40, 41, 42, 43,
+	// camera_y
+	0, 1, 2, 3, 5, 6, 10, 11, 12, 13, 15, 16, 17, 18, 19, 22, 23, 24, 25, 26, 27, 28, 30, 31, 32, 33, 34, 35, 36, 38, 39, 40, 41,
+	// camera_z
+	0, 1, 2, 3, 10, 11, 15, 16, 18, 19, 22, 23, 24, 25, 29, 30, 31, 32, 33, 34, 35, 40, 41,
+	// target_x
+	0, 11, 12, 13, 20, 21, 22, 23, 24, 25, 28, 29, 31, 32, 33, 40, 41, 42, 43,
+	// target_y
+	0, 1, 2, 3, 5, 6, 11, 12, 13, 14, 15, 16, 25, 26, 27, 28, 32, 33, 34, 35, 36, 38, 39, 40, 41,
+	// target_z
+	0, 1, 2, 40, 41,
+	// speed
+	0, 11, 12, 13, 14, 15, 24, 25, 27, 28, 34, 35, 39, 40, 41,
+	// boardEuler_x
+	0, 11, 12, 13, 14, 15, 16, 24, 25, 26, 27, 28, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43,
+	// boardEuler_y
+	0, 23, 24, 25, 26, 27, 28, 29, 34, 35, 36, 37, 38, 39, 40, 41,
+	// boardEuler_z
+	0, 11, 12, 13, 14, 15, 19, 20, 21, 22, 23, 24, 25, 26, 27, 34, 35, 36, 37, 38, 39, 40, 41, 42,
+	// boardPos_x
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 23, 24, 28, 29, 30, 31, 33, 34, 40, 41, 42,
+	// boardPos_y
+	0, 11, 12, 13, 14, 15, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 34, 35, 36, 37, 38, 39, 40, 41, 42,
+	// boardPos_z
+	0, 12, 13, 15, 16, 23, 24, 28, 29, 31, 32, 33, 34, 38, 39, 41, 42,
+	// body_twist
+	0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18, 19, 23, 24, 25, 27, 28, 29, 31, 32, 33, 34, 35, 38, 39, 41, 42,
+	// bodyHipPosition_x
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 18, 19, 23, 24, 27, 28, 29, 30, 31, 32, 33, 34, 38, 39, 40, 41, 42,
+	// bodyHipPosition_y
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 38, 39, 40, 41, 42,
+	// bodyHipPosition_z
+	0, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18, 19, 23, 24, 25, 26, 27, 28, 29, 31, 32, 33, 34, 35, 41, 42,
+	// hip_rotation_r
+	0, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 31, 32, 33, 35, 36, 37, 38, 39,
+	// hip_flexion_r
+	0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 24, 25, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+	// hip_abduction_r
+	0, 2, 3, 8, 9, 15, 16, 18, 19, 20, 21, 22, 23, 24, 26, 27, 28, 29, 31, 32, 33, 34, 41, 42,
+	// knee_flexion_r
+	0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+	// ankle_flexion_r
+	0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 38, 39, 40,
+	// hip_rotation_l
+	0, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 31, 32, 33, 34, 35,
+	// hip_flexion_l
+	0, 3, 4, 5, 6, 7, 8, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 24, 25, 26, 27, 28, 29, 30, 31, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42,
+	// hip_abduction_l
+	0, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42,
+	// knee_flexion_l
+	0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42,
+	// ankle_flexion_l
+	0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42,
+};
+
+constexpr float trackKeyValues[] = {
+	// camera_x
+	1.40129846e-45f, 1.40129846e-45f, -0.199218765f, 0.19921878f, 0.199218765f, -0.597656369f, -0.59765631f, 2.80259693e-45f, 1.40129846e-45f, 0.0996093825f, 0.199218765f, 0.199218765f, 0.39843753f, 0.59765631f, 0.59765631f, 0.39843753f, 0.39843753f, 0.199218765f, 5.60519386e-45f, 0.19921881f, 0.199218765f, 0.39843753f, 0.0996093825f, 0.199218765f, 0.199218765f, -0.39843753f, -0.0996093899f, 1.40129846e-45f, 0.39843753f, 0.39843753f, -1.00000048f, -1.00000012f, 0.398437619f,
+	// camera_y
+	0.50000006f, 0.0498046987f, 0.0498046912f, 0.0996093899f, 0.0996093825f, 0.39843756f, 0.39843753f, 0.19921878f, 0.298828155f, 0.50000006f, 0.50000006f, 0.298828155f, 0.199218765f, 0.0996093825f, 0.199218765f, 0.199218765f, 0.298828155f, 0.298828155f, 0.199218765f, 0.500000238f, 0.50000006f, 0.19921881f, 0.199218765f, 0.0996093825f, 0.199218765f, 0.199218765f, 0.0996093899f, 0.0996093825f, 0.50000006f, 0.50000006f, 0.298828155f, 0.298828155f, 0.199218765f,
+	// camera_z
+	-0.50000006f, 1.40129846e-45f, 0.39843753f, 1.00000024f, 1.00000012f, 0.796875119f, 0.79687506f, 1.00000012f, 1.00000012f, 0.79687506f, 0.79687506f, 0.89843756f, 0.89843756f, 1.09375012f, 1.09375012f, 1.00000012f, 1.00000012f, 1.09375012f, 0.89843756f, 0.597656369f, 1.00000012f, 1.00000012f, -0.0996093825f,
+	// target_x
+	1.40129846e-45f, 1.40129846e-45f, -0.199218765f, 1.40129846e-45f, 1.40129846e-45f, 0.199218765f, 0.199218765f, 0.0996093825f, 0.0996093825f, 0.199218765f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, -1.00000048f, -1.00000012f, 0.398437619f,
+	// target_y
+	1.40129846e-45f, 0.0498046912f, 0.0498046912f, 0.0996093825f, 0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, 0.298828155f, 0.500000238f, 0.398437619f, 0.298828244f, 0.0996093825f, 0.0996093825f, 0.298828155f, 0.199218765f, 0.0996094048f, 0.0996093825f, 1.40129846e-45f, 0.0996093825f, 0.0996093825f, 0.39843753f, 0.39843753f, 0.199218765f, 0.0996093825f, 0.199218765f,
+	// target_z
+	-0.59765631f, -0.59765631f, 1.40129846e-45f, 1.40129846e-45f, -1.00000012f,
+	// speed
+	3.0f, 3.00000048f, 0.500000119f, 0.500000119f, 1.00000024f, 3.00000048f, 3.00000048f, 0.500000119f, 0.500000119f, 3.00000048f, 3.00000048f, 0.500000119f, 0.500000119f, 3.00000048f, 2.80259693e-45f,
+	// boardEuler_x
+	1.40129846e-45f, 1.40129846e-45f, 0.50000006f, 5.50000048f, 6.87500048f, 6.28125143f, 0.0f, 1.40129846e-45f, 0.199218765f, 0.298828155f, 0.199218765f, 4.20389539e-45f, 1.40129846e-45f, 0.39843753f, 4.50000048f, 5.50000048f, 8.06250095f, 13.187501f, 12.5625029f, 0.0f, 1.40129846e-45f, 20.0000057f,
+	// boardEuler_y
+	1.40129846e-45f, 1.40129846e-45f, -0.89843756f, -2.29687524f, -5.50000048f, -8.68750095f, -9.37500095f, 0.0f, 1.40129846e-45f, 0.50000006f, 4.50000048f, 5.68750048f, 6.09375048f, 6.28125048f, 6.28125048f, 0.0f,
+	// boardEuler_z
+	1.40129846e-45f, 1.40129846e-45f, -0.79687506f, -0.0996093974f, -0.0996093974f, 1.40129846e-45f, 1.40129846e-45f, 0.19921878f, 0.0996093974f, 0.19921881f, 0.0996093974f, 0.0996093825f, -0.298828155f, -0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, -0.79687506f, -0.39843753f, -0.39843753f, -0.199218765f, 0.298828155f, 4.20389539e-45f, 4.20389539e-45f, 1.59375012f,
+	// boardPos_x
+	1.40129846e-45f, 1.40129846e-45f, -0.0996093825f, 1.40129846e-45f, -0.199218765f, 0.199218795f, 1.40129846e-45f, -0.199218795f, 0.199218795f, 1.40129846e-45f, -0.0996093825f, 0.0996093825f, -0.199218765f, 0.0996093825f, 0.199218765f, 0.199218765f, 0.0996093825f, -0.0996093825f, 0.298828214f, 1.40129846e-45f, -0.0996093974f, -0.0996093974f, 0.199218765f, 0.199218765f, 1.40129846e-45f, -0.199218765f, 0.199218795f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, 1.50000012f, 0.298828155f,
+	// boardPos_y
+	1.40129846e-45f, 1.40129846e-45f, 0.19921878f, 0.500000179f, 0.19921878f, 4.20389539e-45f, 1.40129846e-45f, 0.0397949368f, 0.0198974665f, 0.0397949368f, 0.0198974665f, 0.0198974628f, 0.0996093825f, 0.298828214f, 0.19921878f, 4.20389539e-45f, 1.40129846e-45f, 0.19921878f, 0.298828214f, 0.298828155f, 0.199218765f, 0.0996093825f, 4.20389539e-45f, 4.20389539e-45f, 0.30859378f,
+	// boardPos_z
+	1.40129846e-45f, 1.40129846e-45f, -0.0996093825f, -0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, 0.0996093825f, 0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, 0.0996093825f, 0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, 0.0996093825f, 0.0996093825f, -1.00000012f,
+	// body_twist
+	-0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, -0.298828185f, -0.298828155f, -0.0996093825f, -0.0996093825f, 1.40129846e-45f, -0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, -0.0996093825f, -0.298828185f, -0.298828155f, -0.0996093825f, -0.0996093825f, -0.199218765f, -0.199218765f, 1.40129846e-45f, 1.40129846e-45f, -0.298828185f, -0.298828155f, -0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, -0.0996093825f, -0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, -0.50000006f,
+	// bodyHipPosition_x
+	1.40129846e-45f, 1.40129846e-45f, -0.0996093825f, 0.049804695f, -0.199218795f, 0.298828214f, 0.0498046912f, -0.199218795f, 0.298828214f, 1.40129846e-45f, -0.0996093825f, 1.40129846e-45f, -0.298828155f, 1.40129846e-45f, 0.199218765f, 0.199218765f, -0.0996093974f, 0.398437589f, 1.40129846e-45f, 4.20389539e-45f, 0.25000003f, 0.25000003f, 0.199218765f, 0.0996093825f, -0.199218795f, 0.298828214f, 0.199218765f, 0.199218765f, -0.0996093825f, -0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, 1.50000012f, 1.40129846e-45f,
+	// bodyHipPosition_y
+	4.20389539e-45f, 4.20389539e-45f, -0.0198974665f, -0.0397949256f, -0.18945314f, -0.0397949331f, -0.0397949331f, -0.199218765f, -0.0299072322f, -0.0198974665f, -0.0198974665f, -0.308593869f, 2.80259693e-45f, 0.398437589f, 0.0996093899f, -0.0198974665f, -0.0397949256f, -0.199218765f, -0.0397949331f, -0.0198974665f, -0.0795898512f, -0.0795898512f, -0.0996093974f, 4.20389539e-45f, 0.298828214f, 2.80259693e-45f, -0.0198974684f, -0.0397949256f, -0.199218765f, -0.0397949331f, -0.0198974665f, -0.0198974665f, -0.308593869f, 2.80259693e-45f, 0.298828155f, 0.298828185f, 2.80259693e-45f, -0.0198974665f, -0.0198974665f, -0.0996093825f,
+	// bodyHipPosition_z
+	-0.0996093825f, -0.0996093825f, 0.0996093825f, 0.0996093825f, -0.0996093825f, -0.0996093825f, -0.199218765f, 1.40129846e-45f, -0.298828155f, -0.199218765f, -0.199218765f, 0.0996093825f, 0.0996093825f, -0.0996093825f, -0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, 0.0996093825f, 0.0996093825f, 1.40129846e-45f, 0.0996093825f, 0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, -0.199218765f, 1.40129846e-45f, 1.40129846e-45f, -1.00000012f,
+	// hip_rotation_r
+	1.40129846e-45f, 1.40129846e-45f, 0.39843753f, 0.39843753f, 0.69921881f, 0.69921881f, 1.40129846e-45f, -0.298828155f, 0.298828155f, 1.40129846e-45f, 0.69921881f, 0.39843753f, 0.39843753f, 0.69921881f, 0.298828214f, 0.199218795f, 0.298828214f, 0.199218795f, 0.199218765f, 0.69921881f, 1.09375012f, 0.79687506f, 1.40129846e-45f, 0.39843753f, 0.39843753f, 0.699218929f, 1.40129846e-45f, 1.40129846e-45f, 0.50000006f, 0.59765631f, 0.59765631f, 1.40129846e-45f,
+	// hip_flexion_r
+	1.40129846e-45f, 1.40129846e-45f, 0.298828214f, 0.0996093825f, -0.50000006f, 0.298828244f, 0.0996093825f, -0.50000006f, 1.40129846e-45f, 1.40129846e-45f, 0.429687589f, -0.0996093899f, 0.0996093974f, 0.500000119f, 1.40129846e-45f, 0.298828185f, 0.0996093825f, -0.50000006f, 1.40129846e-45f, 0.199218795f, 0.199218765f, 0.298828155f, 0.298828185f, 0.0996094048f, 0.298828185f, 0.0996093825f, -0.50000006f, 0.0996093825f, 4.20389539e-45f, 0.429687589f, -0.0996093899f, 0.19921881f, 0.0996093899f, 0.199218765f, 0.39843756f, 4.20389539e-45f,
+	// hip_abduction_r
+	0.199218765f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, 0.199218765f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, 0.199218765f, 0.39843753f, 0.199218765f, 0.39843753f, 0.199218765f, 0.39843753f, 0.39843753f, 0.298828155f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, 0.298828214f, 0.298828155f, 0.199218765f, 0.199218765f, 1.40129846e-45f,
+	// knee_flexion_r
+	1.40129846e-45f, 2.80259693e-45f, 0.50000006f, 0.39843753f, 1.40129846e-45f, 0.50000006f, 0.298828155f, 1.40129846e-45f, 1.40129846e-45f, 0.796875179f, 0.0996093899f, 0.597656429f, 0.699218869f, 1.40129846e-45f, 2.80259693e-45f, 0.50000006f, 0.298828155f, 1.40129846e-45f, 0.500000179f, 0.50000006f, 0.298828155f, 0.597656429f, 0.699218869f, 0.19921881f, 2.80259693e-45f, 0.50000006f, 0.298828155f, 0.19921878f, 4.20389539e-45f, 0.796875179f, 0.0996093899f, 0.597656488f, 0.699218869f, 0.79687506f, 0.796875119f, 4.20389539e-45f,
+	// ankle_flexion_r
+	1.40129846e-45f, 1.40129846e-45f, -0.59765631f, 0.89843756f, 0.0996093825f, -0.59765631f, 0.89843756f, -0.59765631f, 1.40129846e-45f, 1.40129846e-45f, 1.00000036f, -1.00000024f, -0.500000179f, 0.0996093825f, 4.20389539e-45f, -0.597656369f, 0.89843756f, -0.59765631f, 1.40129846e-45f, 0.796875179f, 0.597656429f, 0.796875179f, 0.597656429f, 0.69921881f, 0.89843756f, 0.39843753f, 0.0996093899f, 0.0996093974f, -0.597656369f, 0.89843756f, -0.59765631f, 0.0996093974f, -0.0996093974f, 1.00000036f, -0.39843756f, 5.60519386e-45f, 1.40129846e-45f, 0.39843756f, 1.40129846e-45f,
+	// hip_rotation_l
+	1.40129846e-45f, 1.40129846e-45f, -0.298828155f, -0.298828155f, -0.50000006f, -0.50000006f, 0.0996093825f, 1.00000012f, 0.59765631f, 0.298828155f, -0.50000006f, -0.298828155f, -0.298828155f, -0.50000006f, -0.50000006f, -0.89843756f, -0.50000006f, -0.89843756f, -0.50000006f, -1.09375012f, -0.79687506f, 1.40129846e-45f, 1.40129846e-45f, -0.298828155f, -0.298828155f, -0.50000006f, 1.40129846e-45f, 0.0996093825f, 1.40129846e-45f,
+	// hip_flexion_l
+	0.0996093825f, 0.0996093974f, 0.298828214f, 0.0996093974f, 0.0996093974f, 0.298828214f, 0.0996093974f, 0.0996093825f, 0.398437589f, 0.500000238f, 0.398437589f, 0.39843756f, 0.0996093825f, 0.0996093974f, 0.298828214f, 0.0996093974f, 0.0996093825f, 0.199218765f, 0.199218765f, 0.0996093825f, 0.398437589f, 0.39843756f, 0.0996093825f, 0.0996093974f, 0.298828214f, 0.0996093974f, 0.0996093825f, 0.398437589f, 0.500000238f, 0.398437619f, 0.19921878f, -0.199218795f, 0.398437619f, 0.0996093974f, 0.199218795f, 1.40129846e-45f,
+	// hip_abduction_l
+	0.199218765f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, 0.0996093825f, 1.40129846e-45f, 0.0996093825f, 0.89843756f, 0.50000006f, 0.0996093825f, 0.0996093825f, 1.40129846e-45f, 1.40129846e-45f, 0.0996093825f, 0.0996093899f, 0.199218765f, 0.0996093825f, 0.199218765f, 0.0996093825f, -0.69921881f, 0.0996093825f, 0.0996093825f, 0.199218765f, 1.40129846e-45f, 1.40129846e-45f, -0.0996093825f, -0.0996093825f, 0.0996093825f, 1.40129846e-45f, 0.39843753f, 0.298828155f, 0.298828155f, 0.0996093825f, 0.199218765f, 0.0996093825f, 1.40129846e-45f,
+	// knee_flexion_l
+	0.19921881f, 0.199218795f, 0.59765631f, 0.199218765f, 0.199218795f, 0.59765631f, 0.199218795f, 0.0996094048f, 0.19921881f, 0.796875238f, 0.898437738f, 0.398437589f, 0.796875119f, 0.0996093974f, 0.199218795f, 0.59765631f, 0.199218765f, 0.0996094048f, 0.398437589f, 0.39843753f, 0.500000238f, 0.298828244f, 0.597656429f, 0.699218869f, 0.199218765f, 0.199218795f, 0.59765631f, 0.199218765f, 0.0996093825f, 0.199218765f, 0.796875238f, 0.898437738f, 0.0996094048f, 0.500000119f, 0.0996093974f, 0.699218988f, 0.199218795f, 0.0996093974f, 1.40129846e-45f,
+	// ankle_flexion_l
+	0.0996093825f, 0.0996093825f, 0.298828214f, 0.898437738f, 0.298828155f, 0.298828214f, 1.00000012f, 0.298828214f, -0.0996093825f, 0.199218765f, 1.09375048f, 5.60519386e-45f, -0.298828214f, 0.69921881f, -0.0996093825f, 0.298828214f, 1.00000048f, 0.298828155f, -0.0996093825f, 0.398437589f, 0.39843753f, 0.59765631f, -1.00000012f, 1.40129846e-45f, 0.500000119f, 0.0996093974f, 0.298828214f, 1.00000048f, 0.298828155f, -0.0996093974f, 0.0996093974f, 1.09375048f, 5.60519386e-45f, 5.60519386e-45f, -0.0996093899f, -0.500000179f, -0.39843756f, 0.0996093974f, 0.199218795f, 1.40129846e-45f,
 };
 
 #endif //KEYFRAME_DATA_H_
\ No newline at end of file
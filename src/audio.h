@@ -47,15 +47,20 @@ static MMTIME waveTime {
 static DWORD playbackOffset = 0;
 #endif
 
-// Returns the current audio playback time in seconds
-__forceinline float GetAudioPlaybackTime() {
+// Returns the current audio playback position in samples
+__forceinline DWORD GetAudioPlaybackSample() {
 	waveOutGetPosition(waveOutHandle, &waveTime, sizeof(MMTIME));
 
-	return float(waveTime.u.sample
+	return waveTime.u.sample
 #ifdef DEBUG // offset may be introduced due to seeking
 	+ playbackOffset
 #endif
-	) / SAMPLE_RATE;
+	;
+}
+
+// Returns the current audio playback time in seconds (timing itself stays in samples)
+__forceinline float GetAudioPlaybackTime() {
+	return float(GetAudioPlaybackSample()) * (1.0f / SAMPLE_RATE);
 }
 
 static __forceinline void initAudio() {
@@ -76,15 +81,10 @@ static __forceinline void resumeAudio() {
 	waveOutRestart(waveOutHandle);
 }
 
-void seekAudio(float time) {
-	// Clamp time to valid range
-	if (time < 0.0f) time = 0.0f;
-
-	const float maxTime = float(MAX_SAMPLES) / SAMPLE_RATE;
-	if (time > maxTime) time = maxTime;
-
-	// Convert time to sample index (1 sample = 1 frame = stereo pair)
-	DWORD sampleIndex = DWORD(time * SAMPLE_RATE);
+// Seek to a sample index (1 sample = 1 frame = stereo pair), the same index always gives the same pose
+void seekAudioSample(DWORD sampleIndex) {
+	// Clamp to valid range
+	if (sampleIndex > MAX_SAMPLES) sampleIndex = MAX_SAMPLES;
 
 	// Update global offset tracker
 	playbackOffset = sampleIndex;
@@ -107,22 +107,27 @@ void seekAudio(float time) {
 	waveOutPause(waveOutHandle);
 }
 
+// Seek to a time in seconds, rounded to the nearest sample
+void seekAudio(float time) {
+	// Clamp time to valid range
+	if (time < 0.0f) time = 0.0f;
+
+	const float maxTime = float(MAX_SAMPLES) / SAMPLE_RATE;
+	if (time > maxTime) time = maxTime;
+
+	seekAudioSample(DWORD(time * SAMPLE_RATE + 0.5f));
+}
+
 // Step playback by seconds (+/-)
 void stepAudio(float offset) {
-	// Get current sample position
-	float currentTime = GetAudioPlaybackTime();
-
 	// Calculate new sample position
-	float newSample = GetAudioPlaybackTime() + offset;
+	int newSample = int(GetAudioPlaybackSample()) + int(offset * SAMPLE_RATE);
 
 	// Clamp to valid range
-	if (newSample < 0.0f) newSample = 0.0f;
-
-	const float maxTime = float(MAX_SAMPLES) / SAMPLE_RATE;
-	if (newSample > maxTime) newSample = maxTime;
+	if (newSample < 0) newSample = 0;
 
-	// Seek to that time
-	seekAudio(newSample);
+	// Seek to that sample
+	seekAudioSample(DWORD(newSample));
 }
 
 #endif
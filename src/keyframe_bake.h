@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef KEYFRAME_BAKE_H_
+#define KEYFRAME_BAKE_H_
+
+#include "keyframes.h"
+
+#ifdef DEBUG
+#include <atomic>
+#include <thread>
+#include <vector>
+#endif
+
+// Optional mode (BAKE_KEYFRAMES): every track is sampled once at startup, on the 4klang tick grid
+// Looking up a pose is then an index into a table, plus an optional lerp between neighbouring samples
+
+// Baked samples per 4klang tick, has to divide SAMPLES_PER_TICK (10 gives exactly 60 Hz)
+#ifndef BAKE_SUBTICKS
+#define BAKE_SUBTICKS 10
+#endif
+
+// Lerp between baked samples, or just take the previous one (lerping smears STEP keys over one sample)
+#ifndef BAKE_LERP
+#define BAKE_LERP true
+#endif
+
+#define BAKE_STEP (SAMPLES_PER_TICK / BAKE_SUBTICKS) // Audio samples between baked samples
+#define BAKE_COUNT (MAX_SAMPLES / BAKE_STEP + 1)     // Baked samples per track
+
+// Pose table, sampled at a fixed rate
+struct BakedKeyframes {
+    unsigned int step;  // Audio samples between baked samples
+    float sampleRate;   // Audio samples per second
+    unsigned int count; // Baked samples per track
+    float* samples;     // Baked samples, track by track
+};
+
+static_assert(SAMPLES_PER_TICK % BAKE_SUBTICKS == 0, "BAKE_SUBTICKS has to divide SAMPLES_PER_TICK");
+
+// Sample one track of a timeline at every step of the table (or at steps begin to end, when a reload changed some segments)
+template<size_t T>
+void bakeTrack(BakedKeyframes& baked, const KeyframeTimeline<T>& timeline, unsigned int track, unsigned int begin = 0, unsigned int end = ~0u) {
+    float* out = baked.samples + track * baked.count;
+    unsigned int i = timeline.first[track];
+    unsigned int last = timeline.first[track + 1] - 1;
+    if (end > baked.count)
+        end = baked.count;
+
+    // Key at the first sample, when starting inside the track
+    if (begin)
+        i = timeline.startSample ? findSampleKey(timeline, track, begin * baked.step) : findKey(timeline, track, float(begin * baked.step) / baked.sampleRate);
+
+    for (unsigned int s = begin; s < end; s++) {
+        unsigned int sample = s * baked.step;
+        float time = float(sample) / baked.sampleRate;
+
+        // Samples are taken in order, so keys are too (compared as integers on an integer timeline)
+        while (i < last && (timeline.startSample ? sample >= timeline.startSample[i + 1] : time >= timeline.start[i + 1]))
+            i++;
+
+        out[s] = evaluateSegment(timeline, i, timeline.startSample ? segmentSampleTime(timeline, i, sample) : segmentTime(timeline, i, time));
+    }
+}
+
+// Sample every track (or only the samples a reload changed, begin and end for each track), in parallel for debug builds
+template<size_t T>
+void bakeKeyframes(BakedKeyframes& baked, const KeyframeTimeline<T>& timeline, const unsigned int (*changed)[2]) {
+#ifdef DEBUG
+    std::atomic<unsigned int> next = 0;
+    std::vector<std::thread> workers;
+
+    unsigned int threads = std::thread::hardware_concurrency();
+    for (unsigned int n = 0; n < (threads ? threads : 1); n++) {
+        workers.emplace_back([&]() {
+            for (unsigned int k; (k = next++) < T;)
+                if (!changed)
+                    bakeTrack(baked, timeline, k);
+                else if (changed[k][0] < changed[k][1])
+                    bakeTrack(baked, timeline, k, changed[k][0], changed[k][1]);
+        });
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+#else
+    for (unsigned int k = 0; k < T; k++)
+        bakeTrack(baked, timeline, k);
+#endif
+}
+
+// Look up the pose at an audio sample position
+inline void samplePose(const BakedKeyframes& baked, unsigned int position, float* pose, unsigned int trackCount, bool lerp) {
+    unsigned int i = position / baked.step;
+    float f = float(position - i * baked.step) / baked.step;
+
+    // Hold the last sample
+    if (i >= baked.count - 1) {
+        i = baked.count - 1;
+        lerp = false;
+    }
+
+    for (unsigned int k = 0; k < trackCount; k++) {
+        const float* s = baked.samples + k * baked.count + i;
+        pose[k] = lerp ? s[0] + f * (s[1] - s[0]) : s[0];
+    }
+}
+
+#endif // KEYFRAME_BAKE_H_
@@ -0,0 +1,285 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef KEYFRAME_CACHE_H_
+#define KEYFRAME_CACHE_H_
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+
+// Binary snapshot of the loaded keyframes next to the .json file (keyframes.json.cache), for debug builds and tools
+// Written after every load, and used instead of the .json file while it is unchanged (same size, and same modification
+// time or contents): the compiled tables are used straight from the mapped file, nothing is parsed or compiled
+// Included by keyframe_loader.h, after KeyframeTables
+
+// Increase when anything in the file changes (layout, section types, how keys are compiled)
+#define KEYFRAME_CACHE_VERSION 3
+
+// Arrays in the cache, each 16 byte aligned
+enum CacheSection {
+    CACHE_FIRST,             // unsigned int, TRACK_COUNT + 1
+    CACHE_START,             // float, per key
+    CACHE_INV_DURATION,      // float, per key
+    CACHE_SEGMENTS,          // KeyframeSegment, per key
+    CACHE_START_SAMPLE,      // unsigned int, per key (none on the float timeline)
+    CACHE_SPEED_INTEGRAL,    // KeyframeIntegral, per key of the speed track
+    CACHE_TRACK_STAMPS,      // float, source keys of every track back to back (to find changes on the next load)
+    CACHE_TRACK_VALUES,      // float, packed
+    CACHE_CLIP_KEY_COUNTS,   // unsigned short, TRACK_COUNT per clip
+    CACHE_CLIP_KEY_TIMES,    // float
+    CACHE_CLIP_KEY_VALUES,   // float
+    CACHE_CLIP_LENGTHS,      // float, per clip
+    CACHE_CLIP_START,        // float, per clip key
+    CACHE_CLIP_INV_DURATION, // float, per clip key
+    CACHE_CLIP_SEGMENTS,     // KeyframeSegment, per clip key
+    CACHE_CLIP_INSTANCES,    // ClipInstance
+    CACHE_GENERATORS,        // KeyframeGenerator
+    CACHE_SECTION_COUNT
+};
+
+constexpr size_t cacheElementSize[CACHE_SECTION_COUNT] = {
+    sizeof(unsigned int), sizeof(float), sizeof(float), sizeof(KeyframeSegment), sizeof(unsigned int), sizeof(KeyframeIntegral),
+    sizeof(float), sizeof(float),
+    sizeof(unsigned short), sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(KeyframeSegment), sizeof(ClipInstance),
+    sizeof(KeyframeGenerator)
+};
+
+struct KeyframeCacheHeader {
+    char magic[4];                    // "SK8K"
+    unsigned int version;             // KEYFRAME_CACHE_VERSION
+    unsigned int trackCount;          // TRACK_COUNT
+    unsigned int tickSamples;         // Audio samples per key tick the keys were snapped to (0 on the float timeline)
+    unsigned long long trackListHash; // FNV-1a of the track names, in order (cacheTrackListHash)
+    unsigned long long sourceSize;    // Bytes of the .json file
+    long long sourceTime;             // Modification time of the .json file
+    unsigned long long sourceHash;    // FNV-1a of the .json file
+    float editorTime;                 // Editor's time from the .json file
+    unsigned int sections[CACHE_SECTION_COUNT][2]; // Byte offset and element count of each section
+};
+
+#ifdef KEY_TICK
+#define CACHE_TICK KEY_TICK
+#else
+#define CACHE_TICK 0
+#endif
+
+// 64-bit FNV-1a, to recognize a .json file saved again without changes
+inline unsigned long long hashBytes(const char* data, size_t size) {
+    unsigned long long hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ (unsigned char)data[i]) * 1099511628211ull;
+    return hash;
+}
+
+// FNV-1a of the track names in order, with their terminators, computed by the compiler
+// A cache written with the tracks renamed or reordered is not used, even with the same number of tracks
+constexpr unsigned long long hashTrackList() {
+    unsigned long long hash = 14695981039346656037ull;
+    for (int k = 0; k < TRACK_COUNT + 1; k++) {
+        const char* name = trackKeys[k];
+        do
+            hash = (hash ^ (unsigned char)*name) * 1099511628211ull;
+        while (*name++);
+    }
+    return hash;
+}
+
+constexpr unsigned long long cacheTrackListHash = hashTrackList();
+
+// Size and modification time of a file, false if it can't be read
+inline bool fileStamp(const std::string& filename, unsigned long long& size, long long& time) {
+    std::error_code error;
+    size = (unsigned long long)std::filesystem::file_size(filename, error);
+    if (error)
+        return false;
+    time = (long long)std::filesystem::last_write_time(filename, error).time_since_epoch().count();
+    return !error;
+}
+
+// Snapshot of a table set loaded from the .json file
+// Written to a temporary file first, so a cache is never seen half written
+inline void writeKeyframeCache(const KeyframeTables& tables, const std::string& filename, unsigned long long size, long long time, unsigned long long hash) {
+    KeyframeCacheHeader header = { {'S', 'K', '8', 'K'}, KEYFRAME_CACHE_VERSION, TRACK_COUNT, CACHE_TICK, cacheTrackListHash, size, time, hash, tables.editorTime };
+    const KeyframeTimeline<TRACK_COUNT>& keyframes = tables.timeline;
+    std::string data(sizeof(header), '\0');
+
+    std::vector<float> stamps, values;
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        stamps.insert(stamps.end(), tables.trackStamps[k].begin(), tables.trackStamps[k].end());
+        values.insert(values.end(), tables.trackValues[k].begin(), tables.trackValues[k].end());
+    }
+    unsigned int keys = keyframes.first[TRACK_COUNT];
+
+    auto add = [&](CacheSection section, const void* elements, size_t count) {
+        data.resize((data.size() + 15) & ~size_t(15));
+        header.sections[section][0] = (unsigned int)data.size();
+        header.sections[section][1] = (unsigned int)count;
+        data.append((const char*)elements, count * cacheElementSize[section]);
+    };
+    add(CACHE_FIRST, keyframes.first, TRACK_COUNT + 1);
+    add(CACHE_START, keyframes.start, keys);
+    add(CACHE_INV_DURATION, keyframes.invDuration, keys);
+    add(CACHE_SEGMENTS, keyframes.segments, keys);
+    add(CACHE_START_SAMPLE, keyframes.startSample, keyframes.startSample ? keys : 0);
+    add(CACHE_SPEED_INTEGRAL, tables.speedIntegral, tables.trackStamps[TRACK_SPEED].size());
+    add(CACHE_TRACK_STAMPS, stamps.data(), stamps.size());
+    add(CACHE_TRACK_VALUES, values.data(), values.size());
+    add(CACHE_CLIP_KEY_COUNTS, tables.clipKeyCounts.data(), tables.clipKeyCounts.size());
+    add(CACHE_CLIP_KEY_TIMES, tables.clipKeyTimes.data(), tables.clipKeyTimes.size());
+    add(CACHE_CLIP_KEY_VALUES, tables.clipKeyValues.data(), tables.clipKeyValues.size());
+    add(CACHE_CLIP_LENGTHS, tables.clipLengths.data(), tables.clipLengths.size());
+    add(CACHE_CLIP_START, tables.clipStart.data(), tables.clipStart.size());
+    add(CACHE_CLIP_INV_DURATION, tables.clipInvDuration.data(), tables.clipInvDuration.size());
+    add(CACHE_CLIP_SEGMENTS, tables.clipSegments.data(), tables.clipSegments.size());
+    add(CACHE_CLIP_INSTANCES, tables.clipInstanceTable.data(), tables.clipInstanceTable.size());
+    add(CACHE_GENERATORS, tables.generatorTable.data(), tables.generatorTable.size());
+    memcpy(&data[0], &header, sizeof(header));
+
+    std::string cacheName = filename + ".cache";
+    std::string temporaryName = cacheName + ".tmp";
+    {
+        std::ofstream file(temporaryName, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), (std::streamsize)data.size());
+        if (!file)
+            return; // No cache, the .json file is parsed next time
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryName, cacheName, error);
+}
+
+// Use the cache if the .json file hasn't changed since it was written: the compiled tables point into the mapped file
+// Source keys, clip keys and generators (small) are copied into the table set, like after a load from the .json file
+// Tracks are compared with the previous tables (if any) to find the ones that changed
+inline bool loadKeyframeCache(KeyframeTables& tables, const std::string& filename, const KeyframeTables* previous) {
+    unsigned long long size;
+    long long time;
+    if (!fileStamp(filename, size, time))
+        return false;
+
+    std::unique_ptr<MappedFile> cache = std::make_unique<MappedFile>((filename + ".cache").c_str());
+    if (!cache->data || cache->size < sizeof(KeyframeCacheHeader))
+        return false;
+
+    KeyframeCacheHeader header;
+    memcpy(&header, cache->data, sizeof(header));
+    if (memcmp(header.magic, "SK8K", 4) != 0 || header.version != KEYFRAME_CACHE_VERSION || header.trackCount != TRACK_COUNT ||
+        header.tickSamples != CACHE_TICK || header.trackListHash != cacheTrackListHash || header.sourceSize != size)
+        return false;
+    for (int s = 0; s < CACHE_SECTION_COUNT; s++)
+        if (header.sections[s][0] % 16 || header.sections[s][0] + (unsigned long long)header.sections[s][1] * cacheElementSize[s] > cache->size)
+            return false;
+
+    // A different modification time with the same contents (saved again, checked out) still uses the cache
+    if (header.sourceTime != time) {
+        MappedFile source(filename.c_str());
+        if (!source.data || hashBytes(source.data, source.size) != header.sourceHash)
+            return false;
+    }
+
+    auto section = [&](CacheSection s) { return cache->data + header.sections[s][0]; };
+    auto count = [&](CacheSection s) { return header.sections[s][1]; };
+
+    // Every count is checked against what it is indexed with, a corrupt or stale cache falls back to the .json file
+    // Each track has at least one key (tracks without keys hold zero)
+    if (count(CACHE_FIRST) != TRACK_COUNT + 1)
+        return false;
+    const unsigned int* first = (const unsigned int*)section(CACHE_FIRST);
+    if (first[0] != 0)
+        return false;
+    for (int k = 0; k < TRACK_COUNT; k++)
+        if (first[k + 1] <= first[k])
+            return false;
+
+    unsigned int keys = first[TRACK_COUNT];
+    if (count(CACHE_START) != keys || count(CACHE_INV_DURATION) != keys || count(CACHE_SEGMENTS) != keys ||
+        count(CACHE_TRACK_STAMPS) != keys || count(CACHE_TRACK_VALUES) != keys || count(CACHE_START_SAMPLE) != (CACHE_TICK ? keys : 0) ||
+        count(CACHE_SPEED_INTEGRAL) != first[TRACK_SPEED + 1] - first[TRACK_SPEED])
+        return false;
+
+    // Clips: TRACK_COUNT key counts each, adding up to the clip keys
+    unsigned int clipCount = count(CACHE_CLIP_LENGTHS);
+    if (count(CACHE_CLIP_KEY_COUNTS) != (unsigned long long)clipCount * TRACK_COUNT)
+        return false;
+    const unsigned short* clipCounts = (const unsigned short*)section(CACHE_CLIP_KEY_COUNTS);
+    unsigned long long clipKeys = 0;
+    for (unsigned int i = 0; i < count(CACHE_CLIP_KEY_COUNTS); i++)
+        clipKeys += clipCounts[i];
+    if (count(CACHE_CLIP_KEY_TIMES) != clipKeys || count(CACHE_CLIP_KEY_VALUES) != clipKeys || count(CACHE_CLIP_START) != clipKeys ||
+        count(CACHE_CLIP_INV_DURATION) != clipKeys || count(CACHE_CLIP_SEGMENTS) != clipKeys)
+        return false;
+
+    // Instances and generators index clips and tracks
+    const ClipInstance* instances = (const ClipInstance*)section(CACHE_CLIP_INSTANCES);
+    for (unsigned int i = 0; i < count(CACHE_CLIP_INSTANCES); i++)
+        if (instances[i].clip >= clipCount)
+            return false;
+    const KeyframeGenerator* cachedGenerators = (const KeyframeGenerator*)section(CACHE_GENERATORS);
+    for (unsigned int i = 0; i < count(CACHE_GENERATORS); i++) {
+        const KeyframeGenerator& generator = cachedGenerators[i];
+        if (generator.track < 0 || generator.track >= TRACK_COUNT || generator.input < GENERATOR_SCROLL || generator.input >= TRACK_COUNT ||
+            generator.type < GENERATOR_SINE || generator.type > GENERATOR_LINEAR)
+            return false;
+    }
+
+    // Compiled tables, in place
+    KeyframeTimeline<TRACK_COUNT>& keyframes = tables.timeline;
+    memcpy(keyframes.first, first, sizeof(keyframes.first));
+    keyframes.start = (float*)section(CACHE_START);
+    keyframes.invDuration = (float*)section(CACHE_INV_DURATION);
+    keyframes.segments = (KeyframeSegment*)section(CACHE_SEGMENTS);
+#ifdef KEY_TICK
+    keyframes.startSample = (unsigned int*)section(CACHE_START_SAMPLE);
+    keyframes.tickSamples = KEY_TICK;
+    keyframes.samplePeriod = 1.f / SAMPLE_RATE;
+#endif
+    tables.speedIntegral = (KeyframeIntegral*)section(CACHE_SPEED_INTEGRAL);
+
+    // Source keys, and which tracks changed since the last load
+    const float* stamps = (const float*)section(CACHE_TRACK_STAMPS);
+    const float* values = (const float*)section(CACHE_TRACK_VALUES);
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        tables.trackStamps[k].assign(stamps + first[k], stamps + first[k + 1]);
+        tables.trackValues[k].assign(values + first[k], values + first[k + 1]);
+        diffTrack(tables, previous, k);
+    }
+
+    // Clips: keys copied, compiled tables in place
+    tables.clipKeyCounts.assign(clipCounts, clipCounts + count(CACHE_CLIP_KEY_COUNTS));
+    tables.clipKeyTimes.assign((const float*)section(CACHE_CLIP_KEY_TIMES), (const float*)section(CACHE_CLIP_KEY_TIMES) + count(CACHE_CLIP_KEY_TIMES));
+    tables.clipKeyValues.assign((const float*)section(CACHE_CLIP_KEY_VALUES), (const float*)section(CACHE_CLIP_KEY_VALUES) + count(CACHE_CLIP_KEY_VALUES));
+    tables.clipLengths.assign((const float*)section(CACHE_CLIP_LENGTHS), (const float*)section(CACHE_CLIP_LENGTHS) + count(CACHE_CLIP_LENGTHS));
+
+    tables.clipTable.resize(tables.clipLengths.size());
+    unsigned int offset = 0;
+    for (size_t c = 0; c < tables.clipTable.size(); c++) {
+        KeyframeTimeline<TRACK_COUNT>& timeline = tables.clipTable[c].timeline;
+        timeline = {};
+        timeline.start = (float*)section(CACHE_CLIP_START) + offset;
+        timeline.invDuration = (float*)section(CACHE_CLIP_INV_DURATION) + offset;
+        timeline.segments = (KeyframeSegment*)section(CACHE_CLIP_SEGMENTS) + offset;
+
+        unsigned int clipOffset = 0;
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            timeline.first[k] = clipOffset;
+            clipOffset += tables.clipKeyCounts[c * TRACK_COUNT + k];
+        }
+        timeline.first[TRACK_COUNT] = clipOffset;
+        tables.clipTable[c].length = tables.clipLengths[c];
+        offset += clipOffset;
+    }
+
+    tables.clipInstanceTable.assign(instances, instances + count(CACHE_CLIP_INSTANCES));
+
+    tables.generatorTable.assign(cachedGenerators, cachedGenerators + count(CACHE_GENERATORS));
+
+    // The tables point into the cache, so it stays mapped as long as they do
+    tables.cache = std::move(cache);
+    tables.editorTime = header.editorTime;
+    return true;
+}
+
+#endif // KEYFRAME_CACHE_H_
@@ -0,0 +1,184 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef KEYFRAME_CODEC_H_
+#define KEYFRAME_CODEC_H_
+
+#include "keyframes.h"
+
+#ifdef DEBUG
+#include <vector>
+#endif
+
+// Compact binary keyframe format, decoded into the runtime tables at startup (ENCODED_KEYFRAMES)
+//
+// A little endian bit stream:
+//   time step                                  32 bits, float, seconds per time unit
+//   for every track:
+//     key count                                16 bits
+//     delta bits, and the time of every key    5 bits, then count x delta bits (difference from the previous key, in time units)
+//     value bits                               5 bits (0 for a constant track)
+//     minimum, and the step between values     32 bits, float (and 32 bits, float if value bits > 0)
+//     value of every key                       count x value bits (quantized between the track's minimum and maximum)
+//     shared mode flag, and modes              1 bit, then 3 bits for the whole track, or 3 bits for every key after the first
+
+// Reads the bit stream
+struct BitReader {
+    const unsigned char* data;
+    unsigned int position; // In bits
+};
+
+inline unsigned int readBits(BitReader& reader, unsigned int count) {
+    unsigned int value = 0;
+    for (unsigned int i = 0; i < count; i++, reader.position++)
+        value |= ((reader.data[reader.position >> 3] >> (reader.position & 7)) & 1u) << i;
+    return value;
+}
+
+inline float readFloat(BitReader& reader) {
+    return bitsFloat(readBits(reader, 32));
+}
+
+// Decode every track into the timeline arena (sized for all keys), and compile its segments
+// Values are decoded into a scratch array first (one float per key), as splines read their neighbouring keys
+template<size_t T>
+unsigned int decodeKeyframes(KeyframeTimeline<T>& timeline, const unsigned char* data, float* values) {
+    BitReader reader = { data, 0 };
+    float timeStep = readFloat(reader);
+
+    unsigned int offset = 0;
+    for (unsigned int k = 0; k < T; k++) {
+        unsigned int count = readBits(reader, 16);
+        float* stamps = timeline.start + offset; // Timestamps are decoded in place
+
+        unsigned int deltaBits = readBits(reader, 5);
+        unsigned int time = 0;
+        for (unsigned int i = 0; i < count; i++) {
+            time += readBits(reader, deltaBits);
+            stamps[i] = time * timeStep;
+        }
+
+        unsigned int valueBits = readBits(reader, 5);
+        float minimum = readFloat(reader);
+        float step = valueBits ? readFloat(reader) : 0.f;
+        for (unsigned int i = 0; i < count; i++)
+            values[offset + i] = minimum + readBits(reader, valueBits) * step;
+
+        // Pack modes into the last 4 bits of the values, as compileTrack() expects them
+        unsigned int shared = readBits(reader, 1);
+        unsigned int sharedMode = shared ? readBits(reader, 3) : STEP;
+        for (unsigned int i = 0; i < count; i++) {
+            unsigned int mode = i == 0 ? STEP : shared ? sharedMode : readBits(reader, 3);
+            values[offset + i] = bitsFloat((floatBits(values[offset + i]) & ~0xFu) | mode);
+        }
+
+        timeline.first[k] = offset;
+        compileTrack(timeline, offset, stamps, values + offset, 1, count);
+        offset += count;
+    }
+    timeline.first[T] = offset;
+
+    return offset;
+}
+
+#ifdef DEBUG
+// Writes the bit stream
+struct BitWriter {
+    std::vector<unsigned char> data;
+    unsigned int position = 0; // In bits
+};
+
+inline void writeBits(BitWriter& writer, unsigned int value, unsigned int count) {
+    for (unsigned int i = 0; i < count; i++, writer.position++) {
+        if ((writer.position >> 3) >= writer.data.size())
+            writer.data.push_back(0);
+        writer.data[writer.position >> 3] |= ((value >> i) & 1u) << (writer.position & 7);
+    }
+}
+
+inline void writeFloat(BitWriter& writer, float value) {
+    writeBits(writer, floatBits(value), 32);
+}
+
+// Bits needed to store a value
+inline unsigned int bitWidth(unsigned int value) {
+    unsigned int bits = 0;
+    while (bits < 32 && (value >> bits))
+        bits++;
+    return bits;
+}
+
+// Encode the keys of every track (timestamps and packed values, as kept by the loader)
+// Values of each track are quantized to bits[k] bits (at most 24) over the range they use,
+// timestamps are rounded to multiples of timeStep
+// Nothing is encoded if a track has more keys than its 16 bit key count holds
+template<size_t T>
+std::vector<unsigned char> encodeKeyframes(const std::vector<float> (&stamps)[T], const std::vector<float> (&values)[T], const unsigned int* bits, float timeStep) {
+    for (unsigned int k = 0; k < T; k++)
+        if (stamps[k].size() > 0xFFFF)
+            return {};
+
+    BitWriter writer;
+    writeFloat(writer, timeStep);
+
+    for (unsigned int k = 0; k < T; k++) {
+        unsigned int count = (unsigned int)stamps[k].size();
+        writeBits(writer, count, 16);
+
+        // Timestamps, as differences in time units
+        std::vector<unsigned int> deltas;
+        unsigned int previous = 0, largest = 0;
+        for (float stamp : stamps[k]) {
+            unsigned int time = (unsigned int)(stamp / (double)timeStep + 0.5);
+            deltas.push_back(time - previous);
+            largest = deltas.back() > largest ? deltas.back() : largest;
+            previous = time;
+        }
+        unsigned int deltaBits = bitWidth(largest);
+        writeBits(writer, deltaBits, 5);
+        for (unsigned int delta : deltas)
+            writeBits(writer, delta, deltaBits);
+
+        // Values, with the mode bits cleared (and packed zeros flushed)
+        std::vector<float> unpacked;
+        float minimum = 0.f, maximum = 0.f;
+        for (unsigned int i = 0; i < count; i++) {
+            float value = bitsFloat(floatBits(flushDenormal(values[k][i])) & ~0xFu);
+            unpacked.push_back(value);
+            minimum = i == 0 || value < minimum ? value : minimum;
+            maximum = i == 0 || value > maximum ? value : maximum;
+        }
+
+        unsigned int valueBits = maximum > minimum ? (bits[k] < 24 ? bits[k] : 24) : 0;
+        float step = valueBits ? (maximum - minimum) / float((1u << valueBits) - 1) : 0.f;
+        writeBits(writer, valueBits, 5);
+        writeFloat(writer, minimum);
+        if (valueBits)
+            writeFloat(writer, step);
+        unsigned int largestValue = valueBits ? (1u << valueBits) - 1 : 0;
+        for (float value : unpacked) {
+            unsigned int quantized = valueBits ? (unsigned int)((value - minimum) / step + 0.5f) : 0;
+            writeBits(writer, quantized < largestValue ? quantized : largestValue, valueBits);
+        }
+
+        // Modes, once for the whole track if they are all the same (unknown types are smoothstep)
+        std::vector<unsigned int> modes;
+        bool shared = true;
+        for (unsigned int i = 1; i < count; i++) {
+            unsigned int mode = floatBits(values[k][i]) & 0xF;
+            modes.push_back(mode > SPLINE ? SMOOTHSTEP : mode);
+            shared = shared && modes.back() == modes.front();
+        }
+        writeBits(writer, shared ? 1 : 0, 1);
+        if (shared)
+            writeBits(writer, modes.empty() ? STEP : modes.front(), 3);
+        else
+            for (unsigned int mode : modes)
+                writeBits(writer, mode, 3);
+    }
+
+    return writer.data;
+}
+#endif
+
+#endif // KEYFRAME_CODEC_H_
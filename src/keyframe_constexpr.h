@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef KEYFRAME_CONSTEXPR_H_
+#define KEYFRAME_CONSTEXPR_H_
+
+#include <bit>
+#include <utility>
+
+#include "keyframes.h"
+
+// Optional mode (CONSTEXPR_KEYFRAMES): the release keyframe data is compiled into segments by the compiler
+// There is no compile step at startup, and every track gets a kernel specialized for its interpolation mode
+// Segments take 6 floats per key instead of 1, which costs more in the compressed executable than the code it saves
+
+// Interpolation mode of the segment ending at a packed key (unknown types are smoothstep)
+constexpr int keyframeMode(float value) {
+    int mode = std::bit_cast<unsigned int>(value) & 0xF; // Extract last 4 bits
+    return mode > SPLINE ? SMOOTHSTEP : mode;
+}
+
+// Same as flushDenormal(), evaluated by the compiler
+constexpr float flushConstexprDenormal(float value) {
+    return std::bit_cast<unsigned int>(value) & 0x7F800000 ? value : 0.f;
+}
+
+// Track without a shared interpolation mode
+#define MIXED_MODE -1
+
+// Compiled keyframes of T tracks with K keys in total, laid out like a KeyframeTimeline arena
+template<size_t T, size_t K>
+struct ConstexprKeyframes {
+    unsigned int first[T + 1];
+    float start[K];
+    float invDuration[K];
+    KeyframeSegment segments[K];
+    unsigned int startSample[K]; // Integer timeline (when compiled with a tick grid)
+    int mode[T]; // Interpolation mode shared by every segment of a track, or MIXED_MODE
+};
+
+// Same as compileTrack(), evaluated by the compiler, with the keys of track k read through source(i) and value(i)
+// Timestamps are snapped to a grid of tickSamples audio samples, unless it is zero
+template<size_t T, size_t K, typename Stamp, typename Value>
+constexpr void compileConstexprTrack(ConstexprKeyframes<T, K>& keyframes, unsigned int k, unsigned int offset, unsigned int count, Stamp source, Value value, unsigned int tickSamples, float samplePeriod) {
+    for (unsigned int i = 0; i < count; i++) {
+        float time = source(i);
+        if (tickSamples) {
+            int tick = time > 0.f ? int(time / (samplePeriod * tickSamples) + 0.5f) : 0;
+            keyframes.startSample[offset + i] = tick * tickSamples;
+            time = float(tick * tickSamples) * samplePeriod;
+        }
+        keyframes.start[offset + i] = time;
+    }
+    auto stamp = [&](unsigned int i) { return keyframes.start[offset + i]; };
+
+    keyframes.first[k] = offset;
+    keyframes.mode[k] = count > 1 ? keyframeMode(value(1)) : STEP;
+
+    for (unsigned int i = 0; i < count; i++) {
+        float a = value(i);
+        float b = a;
+        float duration = 0.f;
+
+        if (i + 1 < count) {
+            b = value(i + 1);
+            duration = stamp(i + 1) - stamp(i);
+            if (keyframeMode(b) != keyframes.mode[k])
+                keyframes.mode[k] = MIXED_MODE;
+        }
+
+        int mode = keyframeMode(b);
+        const float* w = interpolationWeights[mode == SPLINE ? SMOOTHSTEP : mode];
+
+        // A packed zero is a denormal (only the mode bits are set), which is slow to compute with
+        a = flushConstexprDenormal(a);
+        b = flushConstexprDenormal(b);
+
+        keyframes.invDuration[offset + i] = duration > 0.f ? 1.f / duration : 0.f; // Last and duplicate keys hold
+
+        if (mode == SPLINE && duration > 0.f) {
+            // Cubic Hermite segment, tangents scaled to the segment length
+            auto tangent = [&](unsigned int j) {
+                unsigned int previous = j > 0 ? j - 1 : j;
+                unsigned int next = j + 1 < count ? j + 1 : j;
+                float span = stamp(next) - stamp(previous);
+                return span > 0.f ? (flushConstexprDenormal(value(next)) - flushConstexprDenormal(value(previous))) / span : 0.f;
+            };
+            float m0 = tangent(i) * duration;
+            float m1 = tangent(i + 1) * duration;
+            keyframes.segments[offset + i] = { { a, m0, 3.f * (b - a) - 2.f * m0 - m1, m0 + m1 - 2.f * (b - a) } };
+        }
+        else {
+            keyframes.segments[offset + i] = { { a, w[0] * (b - a), w[1] * (b - a), w[2] * (b - a) } };
+        }
+    }
+}
+
+// Same as compileKeyframes(), for a keyframe table (every track keyed at the same timestamps)
+template<size_t T, size_t N, size_t S>
+constexpr ConstexprKeyframes<T, T * N> compileConstexprKeyframes(const float(&stamps)[N], const float(&table)[N][S], unsigned int tickSamples = 0, float samplePeriod = 0.f) {
+    static_assert(T <= S, "Keyframe table has fewer columns than tracks");
+
+    ConstexprKeyframes<T, T * N> keyframes = {};
+    for (unsigned int k = 0; k < T; k++)
+        compileConstexprTrack(keyframes, k, k * N, N, [&](unsigned int i) { return stamps[i]; }, [&](unsigned int i) { return table[i][k]; }, tickSamples, samplePeriod);
+    keyframes.first[T] = T * N;
+
+    return keyframes;
+}
+
+// Same as compileTracks(), for the keys of every track stored back to back, timed by an index into shared timestamps
+template<size_t T, size_t M, size_t K, typename Count, typename Index>
+constexpr ConstexprKeyframes<T, K> compileConstexprKeyframes(const Count(&counts)[T], const float(&times)[M], const Index(&stamps)[K], const float(&values)[K], unsigned int tickSamples = 0, float samplePeriod = 0.f) {
+    ConstexprKeyframes<T, K> keyframes = {};
+    unsigned int offset = 0;
+    for (unsigned int k = 0; k < T; offset += counts[k++])
+        compileConstexprTrack(keyframes, k, offset, counts[k], [&](unsigned int i) { return times[stamps[offset + i]]; }, [&](unsigned int i) { return values[offset + i]; }, tickSamples, samplePeriod);
+    keyframes.first[T] = offset;
+
+    return keyframes;
+}
+
+// Timeline pointing into the compiled table, for cursors, baking and uploading (it is never written)
+template<size_t T, size_t K>
+constexpr KeyframeTimeline<T> constexprTimeline(const ConstexprKeyframes<T, K>& keyframes, unsigned int tickSamples = 0, float samplePeriod = 0.f) {
+    KeyframeTimeline<T> timeline = {};
+    for (size_t k = 0; k <= T; k++)
+        timeline.first[k] = keyframes.first[k];
+    timeline.start = const_cast<float*>(keyframes.start);
+    timeline.invDuration = const_cast<float*>(keyframes.invDuration);
+    timeline.segments = const_cast<KeyframeSegment*>(keyframes.segments);
+    if (tickSamples) {
+        timeline.startSample = const_cast<unsigned int*>(keyframes.startSample);
+        timeline.tickSamples = tickSamples;
+        timeline.samplePeriod = samplePeriod;
+    }
+    return timeline;
+}
+
+// Segment evaluation for one interpolation mode, skipping the coefficients it doesn't use
+template<int Mode>
+inline float evaluateMode(const float* c, float t) {
+    if constexpr (Mode == STEP)
+        return c[0];
+    else if constexpr (Mode == LINEAR)
+        return c[0] + t * c[1];
+    else if constexpr (Mode == QUADRATIC_IN)
+        return c[0] + t * t * c[2];
+    else if constexpr (Mode == QUADRATIC_OUT)
+        return c[0] + t * (c[1] + t * c[2]);
+    else if constexpr (Mode == SMOOTHSTEP)
+        return c[0] + t * t * (c[2] + t * c[3]);
+    else if constexpr (Mode == CUBIC_IN)
+        return c[0] + t * t * t * c[3];
+    else
+        return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+
+// Evaluate every track with the kernel of its mode
+template<const auto& Keyframes, size_t T, size_t... K>
+inline void evaluateConstexprPose(const KeyframeCursor<T>& cursor, float* pose, std::index_sequence<K...>) {
+    ((pose[K] = evaluateMode<Keyframes.mode[K]>(Keyframes.segments[cursor.index[K]].c, cursor.t[K])), ...);
+}
+
+template<const auto& Keyframes, size_t T>
+inline void evaluateConstexprPose(const KeyframeCursor<T>& cursor, float* pose) {
+    evaluateConstexprPose<Keyframes>(cursor, pose, std::make_index_sequence<T>());
+}
+
+#endif // KEYFRAME_CONSTEXPR_H_
@@ -0,0 +1,303 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef KEYFRAME_LINK_H_
+#define KEYFRAME_LINK_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Live keyframe push from the editor, for debug builds: the editor writes the tracks it changed into a ring in shared
+// memory and wakes the demo, which compiles them on the keyframe worker and uses them at the start of a frame, like a
+// reload (no file is written or read, so an edit shows up in about a frame)
+// Windows: a named file mapping and an auto-reset event; elsewhere: POSIX shared memory and a Unix datagram socket
+// A background thread waits for the notifications and raises a flag, the render loop reads the ring
+// Included after keyframe_loader.h
+//
+// Ring layout (little endian, offsets in bytes; the editor's writer is tools/keyframe_editor/keyframe_link.py):
+//   0    magic, version, capacity, session (unsigned int; the session is new for every run of the demo, so the editor
+//        knows to push every track again after a restart)
+//   64   head: bytes written by the editor (wraps around), stored after the message
+//   128  tail: bytes read by the demo
+//   192  capacity bytes of messages, each at head % capacity, 4 byte aligned, never split by the end of the ring
+// Message: size (whole message, 0 skips to the start of the ring), editor's time (float), track count, then per track:
+//   key count, name length, name (padded to 4 bytes), timestamps (float), packed values (float, mode in the low 4 bits)
+// A track's keys replace all of its keys, tracks not in a message keep theirs
+
+#define LINK_NAME "sk8_keyframes"
+#define LINK_MAGIC 0x4C384B53u // "SK8L"
+#define LINK_VERSION 2
+#define LINK_CAPACITY (4u << 20) // Bytes of messages (a power of two)
+#define LINK_POLL 100            // Milliseconds between checks for stopping
+
+struct KeyframeLinkRing {
+    unsigned int magic;
+    unsigned int version;
+    unsigned int capacity;
+    unsigned int session;
+    alignas(64) std::atomic<unsigned int> head;
+    alignas(64) std::atomic<unsigned int> tail;
+    alignas(64) unsigned char data[LINK_CAPACITY];
+};
+
+static_assert(offsetof(KeyframeLinkRing, head) == 64 && offsetof(KeyframeLinkRing, tail) == 128 && offsetof(KeyframeLinkRing, data) == 192,
+    "Ring layout is shared with the editor");
+
+struct KeyframeLink {
+    KeyframeLinkRing* ring = nullptr;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+    HANDLE event = nullptr;
+#else
+    int socket = -1;
+    std::string socketPath;
+#endif
+    std::vector<char> pending;           // Messages read from the ring, not compiled yet
+    std::atomic<bool> pushed{ false };   // Raised by the link thread, cleared by the render loop
+    std::atomic<bool> stop{ false };
+    std::thread thread;
+};
+
+// Wait for notifications from the editor
+inline void listenKeyframeLink(KeyframeLink& link) {
+    while (!link.stop.load(std::memory_order_relaxed)) {
+#ifdef _WIN32
+        if (WaitForSingleObject(link.event, LINK_POLL) == WAIT_OBJECT_0)
+            link.pushed.store(true, std::memory_order_release);
+#else
+        pollfd descriptor = { link.socket, POLLIN, 0 };
+        if (poll(&descriptor, 1, LINK_POLL) <= 0)
+            continue;
+
+        char buffer[64];
+        while (recv(link.socket, buffer, sizeof(buffer), MSG_DONTWAIT) >= 0)
+            ; // Only the wake up matters, the messages are in the ring
+        link.pushed.store(true, std::memory_order_release);
+#endif
+    }
+}
+
+// Create the ring and the notification, and start listening; false (with the link unused) if they can't be created
+inline bool startKeyframeLink(KeyframeLink& link) {
+#ifdef _WIN32
+    link.mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(KeyframeLinkRing), "Local\\" LINK_NAME);
+    link.event = CreateEventA(nullptr, FALSE, FALSE, "Local\\" LINK_NAME "_push");
+    if (link.mapping)
+        link.ring = (KeyframeLinkRing*)MapViewOfFile(link.mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(KeyframeLinkRing));
+    if (!link.ring || !link.event) {
+        if (link.ring)
+            UnmapViewOfFile(link.ring);
+        if (link.mapping)
+            CloseHandle(link.mapping);
+        if (link.event)
+            CloseHandle(link.event);
+        link.ring = nullptr;
+        return false;
+    }
+#else
+    int memory = shm_open("/" LINK_NAME, O_CREAT | O_RDWR, 0600);
+    if (memory >= 0 && ftruncate(memory, sizeof(KeyframeLinkRing)) == 0) {
+        void* view = mmap(nullptr, sizeof(KeyframeLinkRing), PROT_READ | PROT_WRITE, MAP_SHARED, memory, 0);
+        link.ring = view != MAP_FAILED ? (KeyframeLinkRing*)view : nullptr;
+    }
+    if (memory >= 0)
+        close(memory);
+
+    // The socket is a file next to the other temporary files, replaced if a previous run left it
+    const char* directory = getenv("TMPDIR");
+    link.socketPath = std::string(directory ? directory : "/tmp") + "/" LINK_NAME ".sock";
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (link.ring && link.socketPath.size() < sizeof(address.sun_path)) {
+        memcpy(address.sun_path, link.socketPath.c_str(), link.socketPath.size() + 1);
+        unlink(link.socketPath.c_str());
+        link.socket = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (link.socket >= 0 && bind(link.socket, (const sockaddr*)&address, sizeof(address)) != 0) {
+            close(link.socket);
+            link.socket = -1;
+        }
+    }
+    if (link.socket < 0) {
+        if (link.ring)
+            munmap(link.ring, sizeof(KeyframeLinkRing));
+        link.ring = nullptr;
+        return false;
+    }
+#endif
+
+    // An editor may hold the ring of a previous run, messages it has left there are dropped
+    link.ring->capacity = LINK_CAPACITY;
+    unsigned int session = (unsigned int)std::chrono::system_clock::now().time_since_epoch().count();
+    link.ring->session = session != link.ring->session ? session : session + 1;
+    link.ring->version = LINK_VERSION;
+    link.ring->magic = LINK_MAGIC;
+    link.ring->tail.store(link.ring->head.load(std::memory_order_acquire), std::memory_order_release);
+
+    link.thread = std::thread(listenKeyframeLink, std::ref(link));
+    return true;
+}
+
+inline void stopKeyframeLink(KeyframeLink& link) {
+    link.stop.store(true, std::memory_order_relaxed);
+    if (link.thread.joinable())
+        link.thread.join();
+    if (!link.ring)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(link.ring);
+    CloseHandle(link.mapping);
+    CloseHandle(link.event);
+#else
+    munmap(link.ring, sizeof(KeyframeLinkRing));
+    close(link.socket);
+    unlink(link.socketPath.c_str());
+    shm_unlink("/" LINK_NAME);
+#endif
+    link.ring = nullptr;
+}
+
+// Copy the messages in the ring to the pending ones, and free their space for the editor
+// A message that doesn't fit the ring (written by something else) drops the rest
+inline void readKeyframeLink(KeyframeLink& link) {
+    KeyframeLinkRing& ring = *link.ring;
+    unsigned int head = ring.head.load(std::memory_order_acquire);
+    unsigned int tail = ring.tail.load(std::memory_order_relaxed);
+    while (tail != head) {
+        unsigned int offset = tail & (LINK_CAPACITY - 1);
+        unsigned int size;
+        memcpy(&size, ring.data + offset, sizeof(size));
+        if (!size && LINK_CAPACITY - offset <= head - tail) {
+            tail += LINK_CAPACITY - offset;
+            continue;
+        }
+        if (size < 12 || size & 3 || size > LINK_CAPACITY - offset || size > head - tail) {
+            tail = head;
+            break;
+        }
+
+        link.pending.insert(link.pending.end(), (const char*)ring.data + offset, (const char*)ring.data + offset + size);
+        tail += size;
+    }
+    ring.tail.store(tail, std::memory_order_release);
+}
+
+// Apply pushed messages to the keys of the previous tables, and compile them (on the worker thread)
+// False if a message is malformed, with the reason in tables.error
+inline bool applyKeyframePush(KeyframeTables& tables, const KeyframeTables* previous, const std::vector<char>& messages, void (*ready)(KeyframeTables*)) {
+    beginKeyframeLoad(tables, previous);
+    if (!previous) {
+        tables.error = "no keyframes loaded to push to";
+        return false;
+    }
+
+    // Keys of every track, then the pushed ones in order (a later push of a track replaces an earlier one)
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        tables.trackStamps[k] = previous->trackStamps[k];
+        tables.trackValues[k] = previous->trackValues[k];
+    }
+
+    try {
+        const char* at = messages.data();
+        const char* end = at + messages.size();
+        auto read = [&](void* to, size_t bytes, const char* limit) {
+            if (bytes > (size_t)(limit - at))
+                throw std::runtime_error("truncated message");
+            memcpy(to, at, bytes);
+            at += bytes;
+        };
+
+        while (at < end) {
+            const char* message = at;
+            unsigned int size, trackCount;
+            read(&size, sizeof(size), end);
+            if (size > (size_t)(end - message))
+                throw std::runtime_error("truncated message");
+            const char* messageEnd = message + size;
+            read(&tables.editorTime, sizeof(float), messageEnd);
+            read(&trackCount, sizeof(trackCount), messageEnd);
+
+            for (unsigned int t = 0; t < trackCount; t++) {
+                unsigned int keyCount, nameLength;
+                read(&keyCount, sizeof(keyCount), messageEnd);
+                read(&nameLength, sizeof(nameLength), messageEnd);
+                if (((nameLength + 3ull) & ~3ull) + keyCount * 2ull * sizeof(float) > (unsigned long long)(messageEnd - at))
+                    throw std::runtime_error("truncated track");
+                const char* name = at;
+                at += (nameLength + 3ull) & ~3ull;
+
+                // Unknown tracks and the timestamps are skipped, like in the .json file
+                int k = findTrack(name, nameLength);
+                if (k == TRACK_TIMESTAMPS || k == TRACK_COUNT) {
+                    at += keyCount * 2 * sizeof(float);
+                    continue;
+                }
+                tables.trackStamps[k].resize(keyCount);
+                tables.trackValues[k].resize(keyCount);
+                read(tables.trackStamps[k].data(), keyCount * sizeof(float), messageEnd);
+                read(tables.trackValues[k].data(), keyCount * sizeof(float), messageEnd);
+            }
+            at = messageEnd;
+        }
+    }
+    catch (const std::exception& e) {
+        tables.error = e.what();
+        return false;
+    }
+
+    compileKeyframeTables(tables, previous);
+
+    // Clips and generators aren't edited, they are taken over
+    tables.clipKeyCounts = previous->clipKeyCounts;
+    tables.clipKeyTimes = previous->clipKeyTimes;
+    tables.clipKeyValues = previous->clipKeyValues;
+    tables.clipLengths = previous->clipLengths;
+    tables.clipInstanceTable = previous->clipInstanceTable;
+    compileClipTables(tables);
+    tables.generatorTable = previous->generatorTable;
+
+#ifdef BAKE_KEYFRAMES
+    bakeKeyframeTables(tables, previous);
+#endif
+    tables.generation = tables.baseGeneration + 1;
+    if (ready)
+        ready(&tables);
+    return true;
+}
+
+// Compile what the editor pushed on the worker thread, when it has been notified (called by the render loop)
+// While the worker is busy, the messages wait, and more are added to them
+inline void pushKeyframes(KeyframeLink& link) {
+    if (!link.ring)
+        return;
+    if (link.pushed.load(std::memory_order_relaxed) && link.pushed.exchange(false, std::memory_order_acquire))
+        readKeyframeLink(link);
+    if (link.pending.empty() || !keyframeWorkerIdle())
+        return;
+
+    auto load = [messages = std::move(link.pending)](KeyframeTables& tables, const KeyframeTables* previous, void (*ready)(KeyframeTables*)) {
+        return applyKeyframePush(tables, previous, messages, ready);
+    };
+    startKeyframeWorker("the editor", std::move(load));
+    link.pending.clear();
+}
+
+#endif // KEYFRAME_LINK_H_
@@ -5,165 +5,693 @@
 #define KEYFRAME_LOADER_H_
 
 #include "keyframes.h"
+#include "tracks.h"
+
+#ifdef BAKE_KEYFRAMES
+#include "keyframe_bake.h"
+#endif
+
+// Pose vector size (rounded up for SIMD)
+#define POSE_STRIDE ((TRACK_COUNT + 3) & ~3)
+
+// Integer timeline: keys are snapped to KEY_SUBTICKS per 4klang tick (10 gives exactly 60 Hz), and found by audio sample
+// Tools built without the song defines keep the float timeline
+#ifdef SAMPLES_PER_TICK
+#ifndef KEY_SUBTICKS
+#define KEY_SUBTICKS 10
+#endif
+
+#define KEY_TICK (SAMPLES_PER_TICK / KEY_SUBTICKS) // Audio samples per key tick
+
+static_assert(SAMPLES_PER_TICK % KEY_SUBTICKS == 0, "KEY_SUBTICKS has to divide SAMPLES_PER_TICK");
+#endif
 
 // Function to load keyframes from JSON
 #ifdef DEBUG
 #include <fstream>
 
 #include "../tools/nlohmann/json.hpp"
+#include "keyframe_parser.h"
 #include <unordered_map>
 #include <vector>
+#include <cstring>
 #include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 using json = nlohmann::json;
 
-constexpr size_t MAX_KEYFRAMES = 64;
+// Everything a load produces: built as a whole (on a worker thread when reloading), and never changed while it is live
+struct KeyframeTables {
+    // Growable arena holding the compiled keys of every track
+    std::vector<float> keyStart;
+    std::vector<float> keyInvDuration;
+    std::vector<KeyframeSegment> keySegments;
+#ifdef KEY_TICK
+    std::vector<unsigned int> keyStartSample;
+#endif
 
-float timestamps[MAX_KEYFRAMES];
+    // Keyframes of every track, pointing into the arena (or into the cache)
+    KeyframeTimeline<TRACK_COUNT> timeline = {};
+
+    // Integral of the speed track (the scroll position), one entry per key
+    std::vector<KeyframeIntegral> speedIntegralTable;
+    KeyframeIntegral* speedIntegral = nullptr;
+
+    // Source keys of each clip (keys of every track of every clip back to back, as in a release header), and instances
+    std::vector<unsigned short> clipKeyCounts;
+    std::vector<float> clipKeyTimes;
+    std::vector<float> clipKeyValues;
+    std::vector<float> clipLengths;
+    std::vector<ClipInstance> clipInstanceTable;
+
+    // Clips compiled into their own arena
+    std::vector<float> clipStart;
+    std::vector<float> clipInvDuration;
+    std::vector<KeyframeSegment> clipSegments;
+    std::vector<KeyframeClip<TRACK_COUNT>> clipTable;
+
+    // Generators added to the tracks
+    std::vector<KeyframeGenerator> generatorTable;
+
+    // Source keys of each track (timestamps and packed values), to find changes on the next load
+    std::vector<float> trackStamps[TRACK_COUNT];
+    std::vector<float> trackValues[TRACK_COUNT];
+    bool trackChanged[TRACK_COUNT];
+    unsigned int changedSegments[TRACK_COUNT][2]; // Segments of each track that differ from the previous tables, begin and end
+
+#ifdef BAKE_KEYFRAMES
+    // Pose table, resampled where the tracks changed
+    std::vector<float> bakedSamples = std::vector<float>(BAKE_COUNT * TRACK_COUNT);
+    BakedKeyframes bakedKeyframes = { BAKE_STEP, SAMPLE_RATE, BAKE_COUNT, bakedSamples.data() };
+    unsigned int changedSamples[TRACK_COUNT][2]; // Baked samples of each track that differ from the previous tables
+#endif
 
-float speed[MAX_KEYFRAMES];
+    // Loads are numbered, so retired tables reused by a reload know if they still hold the load the live tables were compared
+    // with: then only what changed in the live tables has to be brought over, instead of copying everything unchanged
+    unsigned int generation = 0;     // 0 while loading, and after a failed load
+    unsigned int baseGeneration = 0; // Generation of the previous tables
+    bool behind = false;             // Holding the previous tables' base, while loading
 
-float camera_x[MAX_KEYFRAMES];
-float camera_y[MAX_KEYFRAMES];
-float camera_z[MAX_KEYFRAMES];
+    // Cache file the tables point into, if they were loaded from it
+    std::unique_ptr<MappedFile> cache;
 
-float target_x[MAX_KEYFRAMES];
-float target_y[MAX_KEYFRAMES];
-float target_z[MAX_KEYFRAMES];
+    float editorTime = 0.f; // Editor's time from the .json file
+    std::string error;      // Why the load failed, empty if it didn't
+};
 
-float boardEuler_x[MAX_KEYFRAMES];
-float boardEuler_y[MAX_KEYFRAMES];
-float boardEuler_z[MAX_KEYFRAMES];
+// Tables in use, and the retired ones, reused by the next load (their vectors keep their capacity, so reloads hardly allocate)
+std::unique_ptr<KeyframeTables> liveTables;
+std::unique_ptr<KeyframeTables> spareTables;
 
-float boardPos_x[MAX_KEYFRAMES];
-float boardPos_y[MAX_KEYFRAMES];
-float boardPos_z[MAX_KEYFRAMES];
+// The live tables, as the render loop reads them (the same names as in release builds)
+KeyframeTimeline<TRACK_COUNT> keyframes;
+KeyframeIntegral* speedIntegral;
 
-float body_twist[MAX_KEYFRAMES];
+KeyframeClip<TRACK_COUNT>* clipLibrary;
+const ClipInstance* clipInstances;
+unsigned int clipInstanceCount;
 
-float bodyHipPosition_x[MAX_KEYFRAMES];
-float bodyHipPosition_y[MAX_KEYFRAMES];
-float bodyHipPosition_z[MAX_KEYFRAMES];
+const KeyframeGenerator* generators;
+unsigned int generatorCount;
 
-float hip_rotation_r[MAX_KEYFRAMES];
-float hip_flexion_r[MAX_KEYFRAMES];
-float hip_abduction_r[MAX_KEYFRAMES];
+#ifdef BAKE_KEYFRAMES
+BakedKeyframes bakedKeyframes;
+#endif
 
-float knee_flexion_r[MAX_KEYFRAMES];
-float ankle_flexion_r[MAX_KEYFRAMES];
+// Keys of each track from a list of keyframes: timestamps and packed values
+void readKeyframes(const json& keyframes, std::vector<float> (&stamps)[TRACK_COUNT], std::vector<float> (&values)[TRACK_COUNT]) {
+    for (const auto& frame : keyframes) {
+        float time = frame["time"];
+        for (const auto& node : frame["nodes"]) {
+            std::string track = node["track"];
+            float value = node["value"];
+
+            // Override last 4 bits with interpolation type
+            uint32_t int_value;
+            memcpy(&int_value, &value, sizeof(int_value)); // Convert to uint32_t
+            int_value &= ~0xF; // Clear last 4 bits
+            int_value |= (0xF & node["mode"].get<int>()); // Override with interpolation type
+            memcpy(&value, &int_value, sizeof(value)); // Convert back to float
+
+            // Find destination track
+            int k = findTrack(track.data(), track.size());
+            if (k == TRACK_COUNT || k == TRACK_TIMESTAMPS) {
+                // Unknown track, skip or warn
+                continue;
+            }
+
+            // Tracks may skip keyframes, but a repeated timestamp overrides the previous key
+            if (!stamps[k].empty() && stamps[k].back() == time) {
+                values[k].back() = value;
+            }
+            else {
+                stamps[k].push_back(time);
+                values[k].push_back(value);
+            }
+        }
+    }
+}
+
+// Compile every clip from its source keys into its slice of the clip arena
+void compileClipTables(KeyframeTables& tables) {
+    tables.clipStart.resize(tables.clipKeyTimes.size());
+    tables.clipInvDuration.resize(tables.clipKeyTimes.size());
+    tables.clipSegments.resize(tables.clipKeyTimes.size());
+    KeyframeTimeline<TRACK_COUNT> arena = { {}, tables.clipStart.data(), tables.clipInvDuration.data(), tables.clipSegments.data() };
+
+    tables.clipTable.resize(tables.clipLengths.size());
+    compileClips(tables.clipTable.data(), (unsigned int)tables.clipTable.size(), tables.clipKeyCounts.data(), tables.clipLengths.data(),
+        tables.clipKeyTimes.data(), tables.clipKeyValues.data(), arena);
+}
+
+// Clip library and instances (optional "clips" and "instances" in the .json file):
+//   "clips": [{ "name": "push", "length": 1.2, "keyframes": [...] }], keyframes like the main ones, length defaults to the last key
+//   "instances": [{ "clip": "push", "time": 12.0, "scale": 1.0, "weight": 1.0, "repeat": 4 }]
+void readClips(const json& j, KeyframeTables& tables) {
+    std::unordered_map<std::string, unsigned int> clipIndex;
+    tables.clipKeyCounts.clear();
+    tables.clipKeyTimes.clear();
+    tables.clipKeyValues.clear();
+    tables.clipLengths.clear();
+    tables.clipInstanceTable.clear();
+
+    for (const auto& clip : j.value("clips", json::array())) {
+        std::vector<float> stamps[TRACK_COUNT];
+        std::vector<float> values[TRACK_COUNT];
+        readKeyframes(clip["keyframes"], stamps, values);
+
+        float length = 0.f;
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            tables.clipKeyCounts.push_back((unsigned short)stamps[k].size());
+            tables.clipKeyTimes.insert(tables.clipKeyTimes.end(), stamps[k].begin(), stamps[k].end());
+            tables.clipKeyValues.insert(tables.clipKeyValues.end(), values[k].begin(), values[k].end());
+            if (!stamps[k].empty() && stamps[k].back() > length)
+                length = stamps[k].back();
+        }
+        clipIndex[clip["name"]] = (unsigned int)tables.clipLengths.size();
+        tables.clipLengths.push_back(clip.value("length", length));
+    }
 
-float hip_rotation_l[MAX_KEYFRAMES];
-float hip_flexion_l[MAX_KEYFRAMES];
-float hip_abduction_l[MAX_KEYFRAMES];
+    for (const auto& instance : j.value("instances", json::array())) {
+        auto it = clipIndex.find(instance["clip"]);
+        if (it == clipIndex.end())
+            continue; // Unknown clip
 
-float knee_flexion_l[MAX_KEYFRAMES];
-float ankle_flexion_l[MAX_KEYFRAMES];
+        tables.clipInstanceTable.push_back({ it->second, instance["time"], instance.value("scale", 1.f), instance.value("weight", 1.f), instance.value("repeat", 1u) });
+    }
 
-// Temporary buffer
-std::unordered_map<std::string, float*> trackMap = {
-    {"timestamps", timestamps},
+    // Compile every clip into its slice of the clip arena
+    compileClipTables(tables);
+}
 
-    {"speed", speed},
+// Generators (optional "generators" in the .json file), in place of dense keys for periodic motion:
+//   "generators": [{ "track": "bodyHipPosition_y", "type": "sine", "input": "time", "amplitude": 0.02, "frequency": 2.0, "phase": 0.0, "start": 0.0, "end": 10.0 }]
+//   type is "sine", "noise" or "linear", input is "time" (default), "scroll" or the name of a track
+void readGenerators(const json& j, KeyframeTables& tables) {
+    static const std::unordered_map<std::string, int> generatorTypes = { {"sine", GENERATOR_SINE}, {"noise", GENERATOR_NOISE}, {"linear", GENERATOR_LINEAR} };
+    tables.generatorTable.clear();
+
+    for (const auto& generator : j.value("generators", json::array())) {
+        std::string trackName = generator["track"];
+        int track = findTrack(trackName.data(), trackName.size());
+        auto type = generatorTypes.find(generator.value("type", "sine"));
+        if (track == TRACK_COUNT || track == TRACK_TIMESTAMPS || type == generatorTypes.end())
+            continue; // Unknown track or type
+
+        std::string name = generator.value("input", "time");
+        int input = findTrack(name.data(), name.size());
+        int source = name == "time" ? GENERATOR_TIME : name == "scroll" ? GENERATOR_SCROLL : input != TRACK_TIMESTAMPS ? input : TRACK_COUNT;
+        if (source == TRACK_COUNT)
+            continue; // Unknown input
+
+        tables.generatorTable.push_back({ track, type->second, source, generator.value("amplitude", 1.f), generator.value("frequency", 1.f),
+            generator.value("phase", 0.f), generator.value("start", 0.f), generator.value("end", 1e30f) });
+    }
+}
 
-    {"camera_x", camera_x},
-    {"camera_y", camera_y},
-    {"camera_z", camera_z},
+// Find the segments of track k that differ from the previous tables (every segment if there are none)
+// Keys are compared bit for bit (the mode is in the low bits of the values), from the start and from the end, and the
+// segments reading a changed key are the ones around it (splines read two keys on each side)
+void diffTrack(KeyframeTables& tables, const KeyframeTables* previous, int k) {
+    unsigned int count = (unsigned int)tables.trackStamps[k].size();
+    unsigned int* segments = tables.changedSegments[k];
+    if (!previous) {
+        tables.trackChanged[k] = true;
+        segments[0] = 0;
+        segments[1] = count;
+        return;
+    }
 
-    {"target_x", target_x},
-    {"target_y", target_y},
-    {"target_z", target_z},
+    const float* stamps = tables.trackStamps[k].data();
+    const float* values = tables.trackValues[k].data();
+    const float* previousStamps = previous->trackStamps[k].data();
+    const float* previousValues = previous->trackValues[k].data();
+    unsigned int previousCount = (unsigned int)previous->trackStamps[k].size();
+    unsigned int common = count < previousCount ? count : previousCount;
+
+    // A block of keys at a time, then key by key
+    auto same = [&](unsigned int i, unsigned int j, unsigned int keys) {
+        return memcmp(stamps + i, previousStamps + j, keys * sizeof(float)) == 0 && memcmp(values + i, previousValues + j, keys * sizeof(float)) == 0;
+    };
+    const unsigned int block = 64;
+    unsigned int begin = 0, end = 0;
+    while (begin + block <= common && same(begin, begin, block))
+        begin += block;
+    while (begin < common && same(begin, begin, 1))
+        begin++;
+    while (end + block <= common - begin && same(count - end - block, previousCount - end - block, block))
+        end += block;
+    while (end < common - begin && same(count - 1 - end, previousCount - 1 - end, 1))
+        end++;
+    end = count - end;
+
+    tables.trackChanged[k] = count != previousCount || begin < end;
+    segments[0] = tables.trackChanged[k] ? (begin > 2 ? begin - 2 : 0) : count;
+    segments[1] = tables.trackChanged[k] ? (end + 1 < count ? end + 1 : count) : count;
+}
 
-    {"boardEuler_x", boardEuler_x},
-    {"boardEuler_y", boardEuler_y},
-    {"boardEuler_z", boardEuler_z},
+// Copy keys of track k from the previous tables: key i of the track is key i + shift of the previous track
+void copyKeys(KeyframeTables& tables, const KeyframeTables& previous, int k, unsigned int begin, unsigned int end, unsigned int shift) {
+    if (begin >= end)
+        return;
+    unsigned int to = tables.timeline.first[k] + begin;
+    unsigned int from = previous.timeline.first[k] + begin + shift;
+    unsigned int count = end - begin;
+    memcpy(tables.timeline.start + to, previous.timeline.start + from, count * sizeof(float));
+    memcpy(tables.timeline.invDuration + to, previous.timeline.invDuration + from, count * sizeof(float));
+    memcpy(tables.timeline.segments + to, previous.timeline.segments + from, count * sizeof(KeyframeSegment));
+#ifdef KEY_TICK
+    memcpy(tables.timeline.startSample + to, previous.timeline.startSample + from, count * sizeof(unsigned int));
+#endif
+}
 
-    {"boardPos_x", boardPos_x},
-    {"boardPos_y", boardPos_y},
-    {"boardPos_z", boardPos_z},
+// Lay out the source keys of every track in the arena, compile them, and integrate the speed
+// Against previous tables, only the segments that changed are compiled, the others are copied (or, if the tables are
+// behind the previous ones with the same layout, only the segments that changed in the previous tables)
+void compileKeyframeTables(KeyframeTables& tables, const KeyframeTables* previous) {
+    KeyframeTimeline<TRACK_COUNT>& timeline = tables.timeline;
+    bool behind = tables.behind && previous && timeline.start == tables.keyStart.data() && tables.speedIntegral == tables.speedIntegralTable.data() &&
+        memcmp(timeline.first, previous->timeline.first, sizeof(timeline.first)) == 0;
+
+    unsigned int total = 0;
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        // Tracks without keys hold zero
+        if (tables.trackStamps[k].empty()) {
+            tables.trackStamps[k].push_back(0.0f);
+            tables.trackValues[k].push_back(0.0f);
+        }
+        diffTrack(tables, previous, k);
 
-    {"body_twist", body_twist},
+        timeline.first[k] = total;
+        total += (unsigned int)tables.trackStamps[k].size();
+    }
+    timeline.first[TRACK_COUNT] = total;
+    behind = behind && memcmp(timeline.first, previous->timeline.first, sizeof(timeline.first)) == 0;
+
+    tables.keyStart.resize(total);
+    tables.keyInvDuration.resize(total);
+    tables.keySegments.resize(total);
+    timeline.start = tables.keyStart.data();
+    timeline.invDuration = tables.keyInvDuration.data();
+    timeline.segments = tables.keySegments.data();
+#ifdef KEY_TICK
+    tables.keyStartSample.resize(total);
+    timeline.startSample = tables.keyStartSample.data();
+    timeline.tickSamples = KEY_TICK;
+    timeline.samplePeriod = 1.f / SAMPLE_RATE;
+#endif
 
-    {"bodyHipPosition_x", bodyHipPosition_x},
-    {"bodyHipPosition_y", bodyHipPosition_y},
-    {"bodyHipPosition_z", bodyHipPosition_z},
-    
-    {"hip_rotation_r", hip_rotation_r},
-    {"hip_flexion_r", hip_flexion_r},
-    {"hip_abduction_r", hip_abduction_r},
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        unsigned int count = timeline.first[k + 1] - timeline.first[k];
+        const unsigned int* segments = tables.changedSegments[k];
 
-    {"knee_flexion_r", knee_flexion_r},
-    {"ankle_flexion_r", ankle_flexion_r},
+        // Unchanged segments before and after the changed ones first, splines read their timestamps
+        if (behind) {
+            copyKeys(tables, *previous, k, previous->changedSegments[k][0], previous->changedSegments[k][1], 0);
+        }
+        else if (previous) {
+            unsigned int previousCount = previous->timeline.first[k + 1] - previous->timeline.first[k];
+            copyKeys(tables, *previous, k, 0, segments[0], 0);
+            copyKeys(tables, *previous, k, segments[1], count, previousCount - count);
+        }
 
-    {"hip_rotation_l", hip_rotation_l},
-    {"hip_flexion_l", hip_flexion_l},
-    {"hip_abduction_l", hip_abduction_l},
+        // Compile the new data into polynomial segments
+        compileTrack(timeline, timeline.first[k], tables.trackStamps[k].data(), tables.trackValues[k].data(), 1, count, segments[0], segments[1]);
+    }
 
-    {"knee_flexion_l", knee_flexion_l},
-    {"ankle_flexion_l", ankle_flexion_l}
-};
+    // Integrate the speed into the scroll position (every key after a change moves)
+    tables.speedIntegralTable.resize(tables.trackStamps[TRACK_SPEED].size());
+    tables.speedIntegral = tables.speedIntegralTable.data();
+    if (tables.trackChanged[TRACK_SPEED])
+        integrateTrack(timeline, TRACK_SPEED, tables.speedIntegral);
+    else if (!behind || previous->trackChanged[TRACK_SPEED])
+        memcpy(tables.speedIntegral, previous->speedIntegral, tables.speedIntegralTable.size() * sizeof(KeyframeIntegral));
+}
 
-float loadKeyframesFromJSON(const std::string& filename) {
-    float time = 0.0f;
-
-    while (true) {
-        try {
-            // Read file
-            std::ifstream file(filename);
-            if (!file.is_open()) {
-                throw std::runtime_error("Could not open file: " + filename);
-            }
+#ifdef BAKE_KEYFRAMES
+// Resample the changed segments only, over the previous pose table (or over the samples the previous tables changed)
+// Samples from the start of the first changed segment to the start of the first unchanged one after it (baking is on the integer timeline)
+void bakeKeyframeTables(KeyframeTables& tables, const KeyframeTables* previous) {
+    const KeyframeTimeline<TRACK_COUNT>& timeline = tables.timeline;
+    unsigned int (&samples)[TRACK_COUNT][2] = tables.changedSamples;
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        unsigned int count = timeline.first[k + 1] - timeline.first[k];
+        unsigned int begin = tables.changedSegments[k][0], end = tables.changedSegments[k][1];
+        samples[k][0] = samples[k][1] = 0;
+        if (!tables.trackChanged[k])
+            continue;
+
+        samples[k][0] = begin ? timeline.startSample[timeline.first[k] + begin] / BAKE_STEP : 0;
+        samples[k][1] = end < count ? timeline.startSample[timeline.first[k] + end] / BAKE_STEP + 1 : BAKE_COUNT;
+    }
 
-            // Parse JSON
-            json j;
-            file >> j;
-
-            // Map from track to next insertion index
-            std::unordered_map<std::string, size_t> insertIndices;
-
-            for (const auto& frame : j["keyframes"]) {
-                time = frame["time"];
-                for (const auto& node : frame["nodes"]) {
-                    std::string track = node["track"];
-                    float value = node["value"];
-
-                    // Override last 4 bits with interpolation type
-                    uint32_t int_value = *((uint32_t*)&value); // Convert to uint32_t
-                    int_value &= ~0xF; // Clear last 4 bits
-                    int_value |= (0xF & node["mode"].get<int>()); // Override with interpolation type
-                    value = *((float*)&int_value); // Convert back to float
-
-                    // Find destination array pointer
-                    auto it = trackMap.find(track);
-                    if (it == trackMap.end()) {
-                        // Unknown track, skip or warn
-                        continue;
-                    }
-
-                    size_t index = insertIndices[track]++;
-                    if (index >= MAX_KEYFRAMES) {
-                        // Too many keyframes, skip extras
-                        continue;
-                    }
-
-                    // Directly write into the array
-                    
-                    it->second[index] = value;
-                }
-            }
+    if (!previous) {
+        bakeKeyframes(tables.bakedKeyframes, timeline, nullptr);
+        return;
+    }
+    if (tables.behind) {
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            unsigned int begin = previous->changedSamples[k][0], end = previous->changedSamples[k][1];
+            if (begin < end)
+                memcpy(&tables.bakedSamples[k * BAKE_COUNT + begin], &previous->bakedSamples[k * BAKE_COUNT + begin], (end - begin) * sizeof(float));
+        }
+    }
+    else {
+        tables.bakedSamples = previous->bakedSamples;
+    }
+    bakeKeyframes(tables.bakedKeyframes, timeline, samples);
+}
+#endif
+
+#include "keyframe_cache.h"
+
+// Start loading into a table set, against the previous tables (the live ones, or none)
+void beginKeyframeLoad(KeyframeTables& tables, const KeyframeTables* previous) {
+    tables.behind = previous && tables.generation && previous->baseGeneration == tables.generation;
+    tables.generation = 0;
+    tables.baseGeneration = previous ? previous->generation : 0;
+    tables.error.clear();
+    tables.cache.reset();
+}
+
+// Load the .json file (or its cache, while the file is unchanged) into a table set, on any thread
+// False if the file can't be read or parsed (half written by the editor, a typo), with the reason in tables.error
+// Once the tables are complete, ready() is called before the cache is written, so they can be used sooner
+bool loadKeyframeTables(KeyframeTables& tables, const std::string& filename, const KeyframeTables* previous, void (*ready)(KeyframeTables*) = nullptr) {
+    beginKeyframeLoad(tables, previous);
+
+    // Unchanged since the last load: the cache has everything compiled
+    if (loadKeyframeCache(tables, filename, previous)) {
+#ifdef BAKE_KEYFRAMES
+        bakeKeyframeTables(tables, previous);
+#endif
+        tables.generation = tables.baseGeneration + 1;
+        if (ready)
+            ready(&tables);
+        return true;
+    }
+
+    try {
+        // Size and modification time before reading, for the cache
+        unsigned long long size;
+        long long modified;
+        bool stamped = fileStamp(filename, size, modified);
+
+        // Map file
+        MappedFile file(filename.c_str());
+        if (!file.data) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        // Keys of each track: timestamps and packed values, parsed in place
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            tables.trackStamps[k].clear();
+            tables.trackValues[k].clear();
+        }
+
+        KeyframeSections sections;
+        tables.editorTime = parseKeyframeFile(file.data, file.size, tables.trackStamps, tables.trackValues, sections);
+
+        // Clips and generators are small, the JSON library reads them (when the file has them)
+        json j = json::object();
+        if (sections.clips.begin)
+            j["clips"] = json::parse(sections.clips.begin, sections.clips.end);
+        if (sections.instances.begin)
+            j["instances"] = json::parse(sections.instances.begin, sections.instances.end);
+        if (sections.generators.begin)
+            j["generators"] = json::parse(sections.generators.begin, sections.generators.end);
+
+        compileKeyframeTables(tables, previous);
+
+        // Clips are compiled separately, once each however many times they are placed
+        readClips(j, tables);
+        readGenerators(j, tables);
+
+#ifdef BAKE_KEYFRAMES
+        bakeKeyframeTables(tables, previous);
+#endif
+        tables.generation = tables.baseGeneration + 1;
+        if (ready)
+            ready(&tables);
+
+        // Only read from here on, while the tables may be in use
+        // While the live tables still map the previous cache, replacing it may fail (on Windows), then a later load writes it
+        if (stamped)
+            writeKeyframeCache(tables, filename, size, modified, hashBytes(file.data, file.size));
+        return true;
+    }
+    catch (const std::exception& e) {
+        tables.error = e.what();
+        tables.generation = 0;
+        return false;
+    }
+}
+
+// Report a load that failed, the previous tables stay in use
+inline void reportKeyframeError(const std::string& filename, const std::string& error) {
+    std::string message = "Keyframes not loaded from " + filename + ": " + error + "\n";
+    fputs(message.c_str(), stderr);
+#ifdef _WIN32
+    OutputDebugStringA(message.c_str());
+#endif
+}
 
-            // If no exceptions were thrown, return the time value from the JSON
-            return j["time"];
+// Make a table set live, and point the render loop's globals at it (between frames)
+void useKeyframeTables(std::unique_ptr<KeyframeTables> tables) {
+    keyframes = tables->timeline;
+    speedIntegral = tables->speedIntegral;
+    clipLibrary = tables->clipTable.data();
+    clipInstances = tables->clipInstanceTable.data();
+    clipInstanceCount = (unsigned int)tables->clipInstanceTable.size();
+    generators = tables->generatorTable.data();
+    generatorCount = (unsigned int)tables->generatorTable.size();
+#ifdef BAKE_KEYFRAMES
+    bakedKeyframes = tables->bakedKeyframes;
+#endif
+
+    // The retired tables don't need their cache file anymore, so the next load can replace it
+    spareTables = std::move(liveTables);
+    if (spareTables)
+        spareTables->cache.reset();
+    liveTables = std::move(tables);
+}
+
+// Spare tables, or new ones
+std::unique_ptr<KeyframeTables> takeSpareTables() {
+    return spareTables ? std::move(spareTables) : std::make_unique<KeyframeTables>();
+}
+
+// Reloads, parsed and compiled on a worker thread while the render loop keeps using the live tables
+// The worker only reads the live tables (to find changed tracks), and they are only replaced once it has finished
+std::thread keyframeWorker;
+std::atomic<bool> keyframeWorkerBusy{ false };
+std::atomic<KeyframeTables*> finishedTables{ nullptr }; // Handed from the worker to the render loop
+std::string workerSource; // Where the worker's tables come from, for errors
+std::string reloadFilename;
+bool reloadAgain = false; // Requested while the worker was busy
+
+// The worker can take a load: it isn't running one, and the tables of the last one are published
+bool keyframeWorkerIdle() {
+    return !keyframeWorkerBusy.load(std::memory_order_acquire) && !finishedTables.load(std::memory_order_acquire);
+}
+
+// Run load(tables, previous, ready) on the worker thread, into spare tables against the live ones (called by the render loop)
+// False if the worker is busy, or its tables aren't published yet; publishKeyframes() uses the tables once they are ready
+template<typename Load>
+bool startKeyframeWorker(const std::string& source, Load load) {
+    if (!keyframeWorkerIdle())
+        return false;
+    if (keyframeWorker.joinable())
+        keyframeWorker.join();
+
+    KeyframeTables* tables = takeSpareTables().release();
+    const KeyframeTables* previous = liveTables.get();
+    workerSource = source;
+    keyframeWorkerBusy.store(true, std::memory_order_relaxed);
+    keyframeWorker = std::thread([tables, previous, load = std::move(load)] {
+        auto ready = [](KeyframeTables* loaded) { finishedTables.store(loaded, std::memory_order_release); };
+        if (!load(*tables, previous, ready))
+            ready(tables);
+        keyframeWorkerBusy.store(false, std::memory_order_release);
+    });
+    return true;
+}
+
+// Start reloading the .json file on the worker thread (called by the render loop)
+void requestKeyframeReload(const std::string& filename) {
+    reloadFilename = filename;
+    auto load = [filename](KeyframeTables& tables, const KeyframeTables* previous, void (*ready)(KeyframeTables*)) {
+        return loadKeyframeTables(tables, filename, previous, ready);
+    };
+
+    // Started again once the running load is published, the file may have changed since it was read
+    reloadAgain = !startKeyframeWorker(filename, load);
+}
+
+// Use reloaded tables once the worker has finished (called by the render loop, at the start of a frame)
+// True if new tables are in use, with the editor's time from the file; a failed reload is reported and the tables stay
+bool publishKeyframes(float& editorTime) {
+    bool published = false;
+    if (KeyframeTables* tables = finishedTables.exchange(nullptr, std::memory_order_acquire)) {
+        std::unique_ptr<KeyframeTables> finished(tables);
+        if (finished->error.empty()) {
+            editorTime = finished->editorTime;
+            useKeyframeTables(std::move(finished));
+            published = true;
         }
-        catch (const std::exception& e) {
-            // If an exception is thrown, retry with a small delay
-            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Adjust as needed
+        else {
+            reportKeyframeError(workerSource, finished->error);
+            spareTables = std::move(finished);
         }
     }
+
+    if (reloadAgain)
+        requestKeyframeReload(reloadFilename);
+    return published;
+}
+
+// Wait for the worker (before exiting), a load it finished is dropped
+void stopKeyframeReloads() {
+    reloadAgain = false;
+    if (keyframeWorker.joinable())
+        keyframeWorker.join();
+    delete finishedTables.exchange(nullptr, std::memory_order_acquire);
 }
 
+// Load on the calling thread, and use the tables right away (at startup, and in tools)
+// If the file can't be loaded, the error is reported and the previous tables stay, or every track holds zero if there are none
+float loadKeyframesFromJSON(const std::string& filename) {
+    stopKeyframeReloads();
+
+    std::unique_ptr<KeyframeTables> tables = takeSpareTables();
+    if (!loadKeyframeTables(*tables, filename, liveTables.get())) {
+        reportKeyframeError(filename, tables->error);
+        if (liveTables) {
+            spareTables = std::move(tables);
+            return liveTables->editorTime;
+        }
+
+        // Nothing to keep
+        tables->behind = false;
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            tables->trackStamps[k].clear();
+            tables->trackValues[k].clear();
+        }
+        compileKeyframeTables(*tables, nullptr);
+        readClips(json::object(), *tables);
+        readGenerators(json::object(), *tables);
+#ifdef BAKE_KEYFRAMES
+        bakeKeyframeTables(*tables, nullptr);
+#endif
+        tables->editorTime = 0.f;
+        tables->generation = 1;
+    }
+
+    float editorTime = tables->editorTime;
+    useKeyframeTables(std::move(tables));
+    return editorTime;
+}
 
 #else
     #include "../assets/keyframes/keyframe_data.h"
+
+    #if defined(ENCODED_KEYFRAMES)
+    // Keys of every track in the compact binary format, decoded at startup
+    #include "keyframe_codec.h"
+
+    #define KEY_TOTAL ENCODED_KEY_COUNT
+
+    static float keyDecodedValues[KEY_TOTAL];
+
+    #ifdef CONSTEXPR_KEYFRAMES
+    #error "CONSTEXPR_KEYFRAMES needs a keyframe table, not encoded keyframes"
+    #endif
+    #elif defined(SPARSE_KEYFRAMES)
+    // Keys of every track back to back, timed by an index into the shared timestamps, as written by the keyframe reducer
+    static_assert(isMonotonic(trackKeyCounts, sharedKeyTimes, trackKeyTimes), "Keyframe timestamps have to be in increasing order");
+
+    #define KEY_TOTAL (sizeof(trackKeyTimes) / sizeof(*trackKeyTimes))
+    #else
+    // Keyframe table, every track keyed at the same timestamps
+    static_assert(isMonotonic(timestamps), "Keyframe timestamps have to be in increasing order");
+
+    #define KEYFRAME_COUNT (sizeof(timestamps) / sizeof(*timestamps))
+    #define KEY_TOTAL (KEYFRAME_COUNT * TRACK_COUNT)
+    #endif
+
+    #ifdef CONSTEXPR_KEYFRAMES
+    #include "keyframe_constexpr.h"
+
+    // Keyframe data expanded into tracks and compiled during the build
+    #ifdef SPARSE_KEYFRAMES
+    static constexpr ConstexprKeyframes<TRACK_COUNT, KEY_TOTAL> constexprKeyframes = compileConstexprKeyframes<TRACK_COUNT>(trackKeyCounts, sharedKeyTimes, trackKeyTimes, trackKeyValues, KEY_TICK, 1.f / SAMPLE_RATE);
+    #else
+    static constexpr ConstexprKeyframes<TRACK_COUNT, KEY_TOTAL> constexprKeyframes = compileConstexprKeyframes<TRACK_COUNT>(timestamps, keyframeTable, KEY_TICK, 1.f / SAMPLE_RATE);
+    #endif
+    static KeyframeTimeline<TRACK_COUNT> keyframes = constexprTimeline(constexprKeyframes, KEY_TICK, 1.f / SAMPLE_RATE);
+    #else
+    // Keyframe data expanded into tracks and compiled at startup
+    static float keyStart[KEY_TOTAL];
+    static float keyInvDuration[KEY_TOTAL];
+    static KeyframeSegment keySegments[KEY_TOTAL];
+    static unsigned int keyStartSample[KEY_TOTAL];
+
+    static KeyframeTimeline<TRACK_COUNT> keyframes = { {}, keyStart, keyInvDuration, keySegments, keyStartSample, KEY_TICK, 1.f / SAMPLE_RATE };
+    #endif
+
+    // Integral of the speed track (the scroll position), integrated at startup (sized for any track)
+    static KeyframeIntegral speedIntegral[KEY_TOTAL];
+
+    #ifdef KEYFRAME_CLIPS
+    // Clip library, compiled at startup into its own arena, and the instances placing it on the timeline
+    #define CLIP_COUNT (sizeof(clipLengths) / sizeof(*clipLengths))
+    #define CLIP_KEY_TOTAL (sizeof(clipKeyTimes) / sizeof(*clipKeyTimes))
+
+    static_assert(sizeof(clipKeyCounts) == CLIP_COUNT * TRACK_COUNT * sizeof(**clipKeyCounts), "Every clip needs a key count for every track");
+
+    static float clipStart[CLIP_KEY_TOTAL];
+    static float clipInvDuration[CLIP_KEY_TOTAL];
+    static KeyframeSegment clipSegments[CLIP_KEY_TOTAL];
+    static KeyframeTimeline<TRACK_COUNT> clipArena = { {}, clipStart, clipInvDuration, clipSegments };
+
+    static KeyframeClip<TRACK_COUNT> clipLibrary[CLIP_COUNT];
+    static const ClipInstance* clipInstances = clipInstanceTable;
+    static const unsigned int clipInstanceCount = sizeof(clipInstanceTable) / sizeof(*clipInstanceTable);
+    #endif
+
+    #ifdef KEYFRAME_GENERATORS
+    // Generators added to the tracks
+    static const KeyframeGenerator* generators = generatorTable;
+    static const unsigned int generatorCount = sizeof(generatorTable) / sizeof(*generatorTable);
+    #endif
+
+    #ifdef BAKE_KEYFRAMES
+    // Pose table, sampled at startup
+    static float bakedSamples[BAKE_COUNT * TRACK_COUNT];
+    static BakedKeyframes bakedKeyframes = { BAKE_STEP, SAMPLE_RATE, BAKE_COUNT, bakedSamples };
+    #endif
 #endif
 
 #endif // KEYFRAME_LOADER_H_
@@ -0,0 +1,373 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef KEYFRAME_PARSER_H_
+#define KEYFRAME_PARSER_H_
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Keyframe file parser for debug builds: reads the keyframe schema straight from the memory mapped file in one pass,
+// without building a document, copying strings or allocating (the track tables keep their capacity between loads)
+// Optional sections (clips, instances, generators) are only located, and left to the JSON library
+// Included by keyframe_loader.h, after tracks.h (tracks are found by findTrack())
+
+// Read-only view of a whole file, unmapped when it goes out of scope
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+
+    explicit MappedFile(const char* filename) {
+        // The editor can still replace the file while it is mapped
+        file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER length;
+        if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &length) || length.QuadPart == 0)
+            return;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        data = mapping ? (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        size = data ? (size_t)length.QuadPart : 0;
+    }
+
+    ~MappedFile() {
+        if (data)
+            UnmapViewOfFile(data);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+    }
+#else
+    int file = -1;
+
+    explicit MappedFile(const char* filename) {
+        file = open(filename, O_RDONLY);
+        struct stat status;
+        if (file < 0 || fstat(file, &status) != 0 || status.st_size == 0)
+            return;
+        void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, file, 0); // Mapped up front, not a page fault at a time
+        data = view != MAP_FAILED ? (const char*)view : nullptr;
+        size = data ? (size_t)status.st_size : 0;
+    }
+
+    ~MappedFile() {
+        if (data)
+            munmap((void*)data, size);
+        if (file >= 0)
+            close(file);
+    }
+#endif
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+// Bytes of a value in the file (begin is null for a missing one)
+struct JsonSpan {
+    const char* begin;
+    const char* end;
+};
+
+// Optional sections of a keyframe file
+struct KeyframeSections {
+    JsonSpan clips;
+    JsonSpan instances;
+    JsonSpan generators;
+};
+
+// Position in the file
+struct JsonReader {
+    const char* begin;
+    const char* p;
+    const char* end;
+};
+
+[[noreturn]] inline void parseError(const JsonReader& reader, const char* message) {
+    throw std::runtime_error("Keyframe file, byte " + std::to_string(reader.p - reader.begin) + ": " + message);
+}
+
+// Whitespace is mostly the editor's indentation, skipped 8 spaces at a time
+inline void skipSpace(JsonReader& reader) {
+    const char* p = reader.p;
+    while (p < reader.end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+        p++;
+        unsigned long long block;
+        while (p + 8 <= reader.end && (memcpy(&block, p, 8), block == 0x2020202020202020ull))
+            p += 8;
+    }
+    reader.p = p;
+}
+
+// Skip a character if it is next
+inline bool consume(JsonReader& reader, char c) {
+    skipSpace(reader);
+    if (reader.p < reader.end && *reader.p == c) {
+        reader.p++;
+        return true;
+    }
+    return false;
+}
+
+inline void expect(JsonReader& reader, char c) {
+    if (!consume(reader, c))
+        parseError(reader, c == ':' ? "expected ':'" : c == '"' ? "expected a string" : "unexpected character");
+}
+
+// A string in place (escapes are kept as they are, names don't have any)
+inline void readString(JsonReader& reader, const char*& string, size_t& length) {
+    expect(reader, '"');
+    string = reader.p;
+    while (reader.p < reader.end && *reader.p != '"')
+        reader.p += *reader.p == '\\' ? 2 : 1;
+    if (reader.p >= reader.end)
+        parseError(reader, "unterminated string");
+    length = size_t(reader.p++ - string);
+}
+
+// Exact powers of ten, for the fast path below
+constexpr double powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+inline double readNumber(JsonReader& reader) {
+    skipSpace(reader);
+
+    // Short decimals (all the editor writes) are one exact integer divided by an exact power of ten, so correctly rounded
+    const char* p = reader.p;
+    bool negative = p < reader.end && *p == '-';
+    p += negative;
+    unsigned long long mantissa = 0;
+    int digits = 0, decimals = -1;
+    for (; p < reader.end && digits < 16; p++) {
+        if (*p >= '0' && *p <= '9') {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits++;
+            decimals += decimals >= 0;
+        }
+        else if (*p == '.' && decimals < 0) {
+            decimals = 0;
+        }
+        else {
+            break;
+        }
+    }
+    if (digits > 0 && digits < 16 && (p >= reader.end || (*p != 'e' && *p != 'E' && (*p < '0' || *p > '9'))) && p[-1] != '.') {
+        reader.p = p;
+        double value = double(mantissa) / powersOfTen[decimals > 0 ? decimals : 0];
+        return negative ? -value : value;
+    }
+
+    double value;
+    auto [next, error] = std::from_chars(reader.p, reader.end, value);
+    if (error != std::errc())
+        parseError(reader, "expected a number");
+    reader.p = next;
+    return value;
+}
+
+// Skip any value: strings, and objects and arrays by their brackets
+inline void skipValue(JsonReader& reader) {
+    skipSpace(reader);
+    int depth = 0;
+    do {
+        if (reader.p >= reader.end)
+            parseError(reader, "unexpected end of file");
+
+        char c = *reader.p;
+        if (c == '"') {
+            const char* string;
+            size_t length;
+            readString(reader, string, length);
+        }
+        else if (c == '{' || c == '[') {
+            depth++;
+            reader.p++;
+        }
+        else if (c == '}' || c == ']') {
+            depth--;
+            reader.p++;
+        }
+        else {
+            // Numbers and literals end at a separator
+            while (reader.p < reader.end && !strchr(",}] \n\r\t", *reader.p))
+                reader.p++;
+        }
+        skipSpace(reader);
+        if (depth > 0 && reader.p < reader.end && (*reader.p == ',' || *reader.p == ':'))
+            reader.p++;
+    } while (depth > 0);
+}
+
+inline bool isKey(const char* string, size_t length, const char* key) {
+    return length == strlen(key) && memcmp(string, key, length) == 0;
+}
+
+// Nodes of one keyframe, straight into the tracks (same rules as readKeyframes())
+template<size_t T>
+void parseNodes(JsonReader& reader, float time, std::vector<float> (&stamps)[T], std::vector<float> (&values)[T]) {
+    expect(reader, '[');
+    if (consume(reader, ']'))
+        return;
+
+    int hint = TRACK_TIMESTAMPS;
+    do {
+        const char* name = nullptr;
+        size_t length = 0;
+        double value = 0.0;
+        int mode = 0, found = 0;
+
+        expect(reader, '{');
+        if (!consume(reader, '}')) {
+            do {
+                const char* key;
+                size_t keyLength;
+                readString(reader, key, keyLength);
+                expect(reader, ':');
+                if (isKey(key, keyLength, "track")) {
+                    readString(reader, name, length);
+                    found |= 1;
+                }
+                else if (isKey(key, keyLength, "value")) {
+                    value = readNumber(reader);
+                    found |= 2;
+                }
+                else if (isKey(key, keyLength, "mode")) {
+                    mode = int(readNumber(reader));
+                    found |= 4;
+                }
+                else {
+                    skipValue(reader);
+                }
+            } while (consume(reader, ','));
+            expect(reader, '}');
+        }
+        if (found != 7)
+            parseError(reader, "node without a track, value or mode");
+
+        // Override last 4 bits with interpolation type
+        float packed = (float)value;
+        unsigned int bits;
+        memcpy(&bits, &packed, sizeof(bits));
+        bits = (bits & ~0xFu) | (0xF & mode);
+        memcpy(&packed, &bits, sizeof(bits));
+
+        // Unknown tracks and the timestamps are skipped
+        // Keyframes list their tracks in order, so the one after the previous node's track is compared first
+        int k = hint < TRACK_COUNT && isKey(name, length, trackKeys[hint + 1]) ? hint : findTrack(name, length);
+        hint = k + 1;
+        if (k == TRACK_TIMESTAMPS || k == TRACK_COUNT)
+            continue;
+
+        // Tracks may skip keyframes, but a repeated timestamp overrides the previous key
+        if (!stamps[k].empty() && stamps[k].back() == time) {
+            values[k].back() = packed;
+        }
+        else {
+            stamps[k].push_back(time);
+            values[k].push_back(packed);
+        }
+    } while (consume(reader, ','));
+    expect(reader, ']');
+}
+
+// Parse a keyframe file: keys of every track (appended to stamps and values), and the optional sections
+// Returns the editor's time, throws on malformed files
+template<size_t T>
+float parseKeyframeFile(const char* data, size_t size, std::vector<float> (&stamps)[T], std::vector<float> (&values)[T], KeyframeSections& sections) {
+    JsonReader reader = { data, data, data + size };
+    sections = {};
+
+    float editorTime = 0.f;
+    bool hasTime = false, hasKeyframes = false;
+
+    expect(reader, '{');
+    if (!consume(reader, '}')) {
+        do {
+            const char* key;
+            size_t keyLength;
+            readString(reader, key, keyLength);
+            expect(reader, ':');
+
+            JsonSpan* section =
+                isKey(key, keyLength, "clips") ? &sections.clips :
+                isKey(key, keyLength, "instances") ? &sections.instances :
+                isKey(key, keyLength, "generators") ? &sections.generators :
+                nullptr;
+
+            if (isKey(key, keyLength, "time")) {
+                editorTime = (float)readNumber(reader);
+                hasTime = true;
+            }
+            else if (isKey(key, keyLength, "keyframes")) {
+                hasKeyframes = true;
+                expect(reader, '[');
+                if (consume(reader, ']'))
+                    continue;
+                do {
+                    // A keyframe's nodes need its time, which is parsed first if it comes after them
+                    float time = 0.f;
+                    bool hasFrameTime = false;
+                    const char* nodes = nullptr;
+
+                    expect(reader, '{');
+                    if (!consume(reader, '}')) {
+                        do {
+                            const char* field;
+                            size_t fieldLength;
+                            readString(reader, field, fieldLength);
+                            expect(reader, ':');
+                            if (isKey(field, fieldLength, "time")) {
+                                time = (float)readNumber(reader);
+                                hasFrameTime = true;
+                            }
+                            else if (isKey(field, fieldLength, "nodes") && hasFrameTime) {
+                                parseNodes(reader, time, stamps, values);
+                            }
+                            else {
+                                skipSpace(reader);
+                                nodes = isKey(field, fieldLength, "nodes") ? reader.p : nodes;
+                                skipValue(reader);
+                            }
+                        } while (consume(reader, ','));
+                        expect(reader, '}');
+                    }
+                    if (!hasFrameTime)
+                        parseError(reader, "keyframe without a time");
+                    if (nodes) {
+                        JsonReader later = { data, nodes, reader.end };
+                        parseNodes(later, time, stamps, values);
+                    }
+                } while (consume(reader, ','));
+                expect(reader, ']');
+            }
+            else if (section) {
+                skipSpace(reader);
+                section->begin = reader.p;
+                skipValue(reader);
+                section->end = reader.p;
+            }
+            else {
+                skipValue(reader);
+            }
+        } while (consume(reader, ','));
+        expect(reader, '}');
+    }
+    if (!hasTime || !hasKeyframes)
+        parseError(reader, "missing time or keyframes");
+
+    return editorTime;
+}
+
+#endif // KEYFRAME_PARSER_H_
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef KEYFRAME_WATCHER_H_
+#define KEYFRAME_WATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Watches the keyframe file on a background thread, for debug builds, so the render loop only reads a flag
+// Change notifications for the file's directory wake the thread (FindFirstChangeNotification on Windows, inotify on Linux,
+// polling elsewhere). It waits for the editor to finish writing (no notifications for WATCH_DEBOUNCE ms), then raises the
+// flag if the file's size or modification time changed (so other files in the directory, like the cache, are ignored)
+// Included after keyframe_loader.h
+
+#define WATCH_DEBOUNCE 10 // Milliseconds without notifications before a write counts as finished
+#define WATCH_POLL 100    // Milliseconds between checks without notifications, and for stopping
+
+struct FileWatcher {
+    std::string filename;
+    std::atomic<bool> changed{ false }; // Raised by the watcher, cleared by the render loop
+    std::atomic<bool> stop{ false };
+    std::thread thread;
+};
+
+inline void watchFile(FileWatcher& watcher) {
+    unsigned long long size, lastSize = 0;
+    long long time, lastTime = 0;
+    fileStamp(watcher.filename, lastSize, lastTime);
+
+    // Raise the flag if the file is different from the last time
+    auto check = [&] {
+        if (fileStamp(watcher.filename, size, time) && (size != lastSize || time != lastTime)) {
+            lastSize = size;
+            lastTime = time;
+            watcher.changed.store(true, std::memory_order_release);
+        }
+    };
+
+    std::string directory = std::filesystem::path(watcher.filename).parent_path().string();
+    if (directory.empty())
+        directory = ".";
+
+#ifdef _WIN32
+    HANDLE notification = FindFirstChangeNotificationA(directory.c_str(), FALSE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (notification != INVALID_HANDLE_VALUE) {
+        while (!watcher.stop.load(std::memory_order_relaxed)) {
+            if (WaitForSingleObject(notification, WATCH_POLL) != WAIT_OBJECT_0)
+                continue;
+
+            // Wait for the writes to settle
+            do {
+                FindNextChangeNotification(notification);
+            } while (WaitForSingleObject(notification, WATCH_DEBOUNCE) == WAIT_OBJECT_0);
+            check();
+        }
+        FindCloseChangeNotification(notification);
+        return;
+    }
+#elif defined(__linux__)
+    // The directory is watched, as editors may replace the file instead of writing it
+    int events = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (events >= 0 && inotify_add_watch(events, directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE) >= 0) {
+        pollfd descriptor = { events, POLLIN, 0 };
+        alignas(inotify_event) char buffer[4096];
+        while (!watcher.stop.load(std::memory_order_relaxed)) {
+            if (poll(&descriptor, 1, WATCH_POLL) <= 0)
+                continue;
+
+            // Wait for the writes to settle
+            do {
+                while (read(events, buffer, sizeof(buffer)) > 0)
+                    ; // Only the file's stamp matters, not the events
+            } while (poll(&descriptor, 1, WATCH_DEBOUNCE) > 0);
+            check();
+        }
+        close(events);
+        return;
+    }
+    if (events >= 0)
+        close(events);
+#endif
+
+    // Polling fallback
+    while (!watcher.stop.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WATCH_POLL));
+        check();
+    }
+}
+
+inline void startWatcher(FileWatcher& watcher, const std::string& filename) {
+    watcher.filename = filename;
+    watcher.thread = std::thread(watchFile, std::ref(watcher));
+}
+
+inline void stopWatcher(FileWatcher& watcher) {
+    watcher.stop.store(true, std::memory_order_relaxed);
+    if (watcher.thread.joinable())
+        watcher.thread.join();
+}
+
+// True once for every change (called by the render loop)
+inline bool fileChanged(FileWatcher& watcher) {
+    return watcher.changed.load(std::memory_order_relaxed) && watcher.changed.exchange(false, std::memory_order_acquire);
+}
+
+#endif // KEYFRAME_WATCHER_H_
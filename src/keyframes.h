@@ -4,9 +4,17 @@
 #ifndef KEYFRAMES_H_
 #define KEYFRAMES_H_
 
+#include <stddef.h>
+
 // Compact type definition for 8-bit ints
 typedef unsigned char uint8_t;
 
+// SSE2 is used for batch evaluation where available (not in size optimized x86 builds)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define KEYFRAME_SIMD
+    #include <emmintrin.h>
+#endif
+
 // Interpolation types
 #define INTERP_STEP(a,b,t)          (a)
 #define INTERP_LINEAR(a,b,t)        ((a) + (t) * ((b) - (a)))
@@ -24,38 +32,678 @@ typedef unsigned char uint8_t;
 #define QUADRATIC_IN 2
 #define QUADRATIC_OUT 3
 #define SMOOTHSTEP 4
+#define CUBIC_IN 5
+#define CUBIC_OUT 6
+#define SPLINE 7 // Catmull-Rom, tangents from the neighbouring keys
 
-// Timestamps are either loaded or defined
-#ifdef DEBUG
-extern float timestamps[];
-#else
-extern const float timestamps[];
-#endif
-
-// Interpolation function template
-template<size_t N>
-float findValue(float time, const float(&keys)[N]) {
-    // Find previous and next keyframes
-    uint8_t i;
-    for (i = 1; (i < N) && (time >= timestamps[i]); i++);
+// Bits of a float, read through a union (casting the pointer breaks strict aliasing)
+inline unsigned int floatBits(float value) {
+    union { float f; unsigned int bits; } pun = { value };
+    return pun.bits;
+}
 
-    float t = (time - timestamps[i - 1]) / (timestamps[i] - timestamps[i - 1]);
+// Float of some bits, the other way around
+inline float bitsFloat(unsigned int bits) {
+    union { unsigned int bits; float f; } pun = { bits };
+    return pun.f;
+}
 
-    float a = keys[i - 1];
-    float b = keys[i];
+// Largest integer not above a float, within 2^22, without the CRT (a cast calls __ftol2 on x86 without SSE):
+// adding 1.5 * 2^23 leaves the nearest integer in the low bits of the mantissa
+inline int floorToInt(float value) {
+    int nearest = int(floatBits(value + 12582912.f) - 0x4B400000u);
+    return float(nearest) > value ? nearest - 1 : nearest;
+}
 
-    uint8_t mode = *((unsigned int*)&b) & 0xF; // Extract last 4 bits
+// Reference interpolation between two packed keyframes, mode is encoded in the later one
+// Splines need the neighbouring keys too, here they fall back to smoothstep
+inline float interpolate(float a, float b, float t) {
+    uint8_t mode = floatBits(b) & 0xF; // Extract last 4 bits
 
-    // Interpolate
     return
         mode == STEP ? INTERP_STEP(a, b, t) :
         mode == LINEAR ? INTERP_LINEAR(a, b, t) :
         mode == QUADRATIC_IN ? INTERP_QUADRATIC_IN(a, b, t) :
         mode == QUADRATIC_OUT ? INTERP_QUADRATIC_OUT(a, b, t) :
+        mode == CUBIC_IN ? INTERP_CUBIC_IN(a, b, t) :
+        mode == CUBIC_OUT ? INTERP_CUBIC_OUT(a, b, t) :
         INTERP_SMOOTHSTEP(a, b, t);
+}
+
+// Every interpolation type (except splines) is a cubic blend weight: w(t) = w1*t + w2*t^2 + w3*t^3
+// The INTERP_* macros above, expanded into polynomial form
+static constexpr float interpolationWeights[][3] = {
+    {  0.f,  0.f,  0.f }, // STEP
+    {  1.f,  0.f,  0.f }, // LINEAR
+    {  0.f,  1.f,  0.f }, // QUADRATIC_IN
+    {  2.f, -1.f,  0.f }, // QUADRATIC_OUT
+    {  0.f,  3.f, -2.f }, // SMOOTHSTEP
+    {  0.f,  0.f,  1.f }, // CUBIC_IN
+    {  3.f, -3.f,  1.f }, // CUBIC_OUT
+};
+
+// Every track has its own keys, stored back to back in shared arrays (an arena):
+//   keys of track k are [first[k], first[k + 1])
+//
+// At load time, packed keys are compiled into polynomial segments (splines too, with their tangents):
+//   value = c0 + t * (c1 + t * (c2 + t * c3)), with t = (time - start) * invDuration
+// Evaluation is then free of branches and divisions
+// Key j holds the segment starting at it (towards key j+1), the last key of a track holds its value
+//
+// Optionally (startSample set), keys are also placed on an integer timeline of audio samples, snapped to a grid of
+// tickSamples when compiled. Segments are then found by comparing integers against the audio playback position
+
+// Polynomial coefficients of one segment
+struct alignas(16) KeyframeSegment {
+    float c[4];
+};
+
+// Compiled keyframes of T tracks
+template<size_t T>
+struct KeyframeTimeline {
+    unsigned int first[T + 1];  // First key of each track, and the total number of keys
+    float* start;               // Timestamp of each key
+    float* invDuration;         // Reciprocal length of the segment starting at each key
+    KeyframeSegment* segments;  // Polynomial of the segment starting at each key
+    unsigned int* startSample;  // Audio sample of each key on the integer timeline (or nullptr)
+    unsigned int tickSamples;   // Audio samples per tick of the grid keys are snapped to
+    float samplePeriod;         // Seconds per audio sample
+};
+
+// Denormals as zero
+inline float flushDenormal(float value) {
+    return floatBits(value) & 0x7F800000 ? value : 0.f;
+}
+
+// Tangent of a track at key i (per second), from the keys before and after it (one sided at the ends)
+inline float splineTangent(const float* stamps, const float* values, size_t stride, unsigned int count, unsigned int i) {
+    unsigned int previous = i > 0 ? i - 1 : i;
+    unsigned int next = i + 1 < count ? i + 1 : i;
+    float duration = stamps[next] - stamps[previous];
+    return duration > 0.f ? (flushDenormal(values[next * stride]) - flushDenormal(values[previous * stride])) / duration : 0.f;
+}
+
+// Compile the keys of one track (timestamps and packed values) into segments, starting at key offset
+// Values may be strided, to read a column of a keyframe table
+// A reload may compile only segments begin to end, the timestamps around them have to be compiled already (splines read them)
+template<size_t T>
+void compileTrack(KeyframeTimeline<T>& timeline, unsigned int offset, const float* stamps, const float* values, size_t stride, unsigned int count,
+    unsigned int begin = 0, unsigned int end = ~0u) {
+    if (end > count)
+        end = count;
+
+    // Timestamps first (splines read the neighbouring ones), snapped to the tick grid on an integer timeline
+    for (unsigned int i = begin; i < end; i++) {
+        float stamp = stamps[i];
+        if (timeline.startSample) {
+            int tick = stamp > 0.f ? floorToInt(stamp / (timeline.samplePeriod * timeline.tickSamples) + 0.5f) : 0;
+            timeline.startSample[offset + i] = tick * timeline.tickSamples;
+            stamp = float(tick * timeline.tickSamples) * timeline.samplePeriod;
+        }
+        timeline.start[offset + i] = stamp;
+    }
+    stamps = timeline.start + offset;
+
+    for (unsigned int i = begin; i < end; i++) {
+        float a = values[i * stride];
+        float b = a;
+        float duration = 0.f;
+
+        if (i + 1 < count) {
+            b = values[(i + 1) * stride];
+            duration = stamps[i + 1] - stamps[i];
+        }
+
+        uint8_t mode = floatBits(b) & 0xF; // Extract last 4 bits
+        const float* w = interpolationWeights[mode > CUBIC_OUT ? SMOOTHSTEP : mode];
+
+        // A packed zero is a denormal (only the mode bits are set), which is slow to compute with
+        a = flushDenormal(a);
+        b = flushDenormal(b);
+
+        timeline.invDuration[offset + i] = duration > 0.f ? 1.f / duration : 0.f; // Last and duplicate keys hold
+
+        KeyframeSegment& segment = timeline.segments[offset + i];
+        segment.c[0] = a;
+        if (mode == SPLINE && duration > 0.f) {
+            // Cubic Hermite segment, tangents scaled to the segment length
+            float m0 = splineTangent(stamps, values, stride, count, i) * duration;
+            float m1 = splineTangent(stamps, values, stride, count, i + 1) * duration;
+            segment.c[1] = m0;
+            segment.c[2] = 3.f * (b - a) - 2.f * m0 - m1;
+            segment.c[3] = m0 + m1 - 2.f * (b - a);
+        }
+        else {
+            segment.c[1] = w[0] * (b - a);
+            segment.c[2] = w[1] * (b - a);
+            segment.c[3] = w[2] * (b - a);
+        }
+    }
+}
+
+// Compile a packed keyframe table (every track keyed at the same timestamps)
+template<size_t T, size_t N, size_t S>
+void compileKeyframes(KeyframeTimeline<T>& timeline, const float(&stamps)[N], const float(&table)[N][S]) {
+    for (unsigned int k = 0; k < T; k++) {
+        timeline.first[k] = k * N;
+        compileTrack(timeline, k * N, stamps, &table[0][k], S, N);
+    }
+    timeline.first[T] = T * N;
+}
+
+// Compile packed keys of every track, stored back to back (counts[k] keys for track k)
+template<size_t T, typename Count>
+void compileTracks(KeyframeTimeline<T>& timeline, const Count* counts, const float* stamps, const float* values) {
+    unsigned int offset = 0;
+    for (unsigned int k = 0; k < T; k++) {
+        timeline.first[k] = offset;
+        compileTrack(timeline, offset, stamps + offset, values + offset, 1, counts[k]);
+        offset += counts[k];
+    }
+    timeline.first[T] = offset;
+}
+
+// Timestamps of a keyframe table have to be in order (repeated timestamps are allowed, and hold)
+template<size_t N>
+constexpr bool isMonotonic(const float(&stamps)[N]) {
+    for (size_t i = 1; i < N; i++)
+        if (!(stamps[i] >= stamps[i - 1]))
+            return false;
+    return true;
+}
+
+// Same for the keys of every track, stored back to back, timed by an index into shared timestamps
+// (every track needs a key, counts have to add up, and indices have to be in range)
+template<size_t T, size_t M, size_t N, typename Count, typename Index>
+constexpr bool isMonotonic(const Count(&counts)[T], const float(&times)[M], const Index(&stamps)[N]) {
+    size_t offset = 0;
+    for (size_t k = 0; k < T; offset += counts[k++]) {
+        if (counts[k] == 0)
+            return false;
+        for (size_t i = 0; i < counts[k]; i++)
+            if (offset + i >= N || stamps[offset + i] >= M || (i && !(times[stamps[offset + i]] >= times[stamps[offset + i - 1]])))
+                return false;
+    }
+    return offset == N;
+}
+
+// Find the last key of a track at or before time (or its first key), by binary search
+template<size_t T>
+unsigned int findKey(const KeyframeTimeline<T>& timeline, unsigned int track, float time) {
+    unsigned int i = timeline.first[track];
+    unsigned int count = timeline.first[track + 1] - i;
+
+    while (count > 1) {
+        unsigned int half = count / 2;
+        if (time >= timeline.start[i + half]) {
+            i += half;
+            count -= half;
+        }
+        else {
+            count = half;
+        }
+    }
+    return i;
+}
+
+// Normalized time inside the segment starting at key i (held before the first key)
+template<size_t T>
+inline float segmentTime(const KeyframeTimeline<T>& timeline, unsigned int i, float time) {
+    float t = (time - timeline.start[i]) * timeline.invDuration[i];
+    return t > 0.f ? t : 0.f;
+}
+
+// Evaluate the segment starting at key i
+template<size_t T>
+inline float evaluateSegment(const KeyframeTimeline<T>& timeline, unsigned int i, float t) {
+    const float* c = timeline.segments[i].c;
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+
+// Derivative of the segment starting at key i, per unit of normalized time
+template<size_t T>
+inline float evaluateSegmentDerivative(const KeyframeTimeline<T>& timeline, unsigned int i, float t) {
+    const float* c = timeline.segments[i].c;
+    return c[1] + t * (2.f * c[2] + t * 3.f * c[3]);
+}
+
+// Normalized time per second inside the segment starting at key i (zero while held before the first key)
+template<size_t T>
+inline float segmentRate(const KeyframeTimeline<T>& timeline, unsigned int i, float time) {
+    return time >= timeline.start[i] ? timeline.invDuration[i] : 0.f;
+}
+
+// Same as findKey(), by audio sample on an integer timeline
+template<size_t T>
+unsigned int findSampleKey(const KeyframeTimeline<T>& timeline, unsigned int track, unsigned int sample) {
+    unsigned int i = timeline.first[track];
+    unsigned int count = timeline.first[track + 1] - i;
+
+    while (count > 1) {
+        unsigned int half = count / 2;
+        if (sample >= timeline.startSample[i + half]) {
+            i += half;
+            count -= half;
+        }
+        else {
+            count = half;
+        }
+    }
+    return i;
+}
+
+// Same as segmentTime(), by audio sample (the offset into the segment is exact, only scaling it is rounded)
+template<size_t T>
+inline float segmentSampleTime(const KeyframeTimeline<T>& timeline, unsigned int i, unsigned int sample) {
+    float t = float(int(sample - timeline.startSample[i])) * timeline.samplePeriod * timeline.invDuration[i];
+    return t > 0.f ? t : 0.f;
+}
+
+// Interpolation function template
+template<size_t T>
+float findValue(float time, const KeyframeTimeline<T>& timeline, unsigned int track) {
+    unsigned int i = findKey(timeline, track, time);
+    return evaluateSegment(timeline, i, segmentTime(timeline, i, time));
+}
+
+// Interpolation, along with the time derivative (per second) from the same segment
+// STEP keys, holds and the end of a track have a derivative of zero
+template<size_t T>
+float findValue(float time, const KeyframeTimeline<T>& timeline, unsigned int track, float& derivative) {
+    unsigned int i = findKey(timeline, track, time);
+    float t = segmentTime(timeline, i, time);
+    derivative = evaluateSegmentDerivative(timeline, i, t) * segmentRate(timeline, i, time);
+    return evaluateSegment(timeline, i, t);
+}
+
+// Interpolation by audio sample, on an integer timeline
+template<size_t T>
+float findSampleValue(unsigned int sample, const KeyframeTimeline<T>& timeline, unsigned int track) {
+    unsigned int i = findSampleKey(timeline, track, sample);
+    return evaluateSegment(timeline, i, segmentSampleTime(timeline, i, sample));
+}
+
+// Active segment of every track
+template<size_t T>
+struct KeyframeCursor {
+    unsigned int index[T];     // Key at the start of the active segment
+    alignas(16) float t[T];    // Normalized time inside the active segment
+    alignas(16) float rate[T]; // Normalized time per second inside the active segment, for derivatives
+};
+
+// Move the cursor of every track to the segment containing time, once per frame
+template<size_t T>
+void updateCursor(KeyframeCursor<T>& cursor, float time, const KeyframeTimeline<T>& timeline) {
+    for (unsigned int k = 0; k < T; k++) {
+        unsigned int i = cursor.index[k];
+        unsigned int last = timeline.first[k + 1] - 1;
+
+        // Normal playback stays in the segment, or moves to the next one
+        if (i >= timeline.first[k] && i <= last && time >= timeline.start[i] &&
+            (i + 2 > last || time < timeline.start[i + 2])) {
+            if (i < last && time >= timeline.start[i + 1])
+                i++;
+        }
+        // Otherwise (seeking, reloading) search again
+        else {
+            i = findKey(timeline, k, time);
+        }
+
+        cursor.index[k] = i;
+        cursor.t[k] = segmentTime(timeline, i, time);
+        cursor.rate[k] = segmentRate(timeline, i, time);
+    }
+}
+
+// Same as updateCursor(), by audio sample on an integer timeline: seeking to a sample always gives the same pose
+template<size_t T>
+void updateCursorSample(KeyframeCursor<T>& cursor, unsigned int sample, const KeyframeTimeline<T>& timeline) {
+    for (unsigned int k = 0; k < T; k++) {
+        unsigned int i = cursor.index[k];
+        unsigned int last = timeline.first[k + 1] - 1;
+
+        // Normal playback stays in the segment, or moves to the next one
+        if (i >= timeline.first[k] && i <= last && sample >= timeline.startSample[i] &&
+            (i + 2 > last || sample < timeline.startSample[i + 2])) {
+            if (i < last && sample >= timeline.startSample[i + 1])
+                i++;
+        }
+        // Otherwise (seeking, reloading) search again
+        else {
+            i = findSampleKey(timeline, k, sample);
+        }
+
+        cursor.index[k] = i;
+        cursor.t[k] = segmentSampleTime(timeline, i, sample);
+        cursor.rate[k] = sample >= timeline.startSample[i] ? timeline.invDuration[i] : 0.f;
+    }
+}
+
+// Interpolation using the segment already found by the cursor
+template<size_t T>
+float findValue(const KeyframeCursor<T>& cursor, const KeyframeTimeline<T>& timeline, unsigned int track) {
+    return evaluateSegment(timeline, cursor.index[track], cursor.t[track]);
+}
+
+// Interpolation and time derivative, using the segment already found by the cursor
+template<size_t T>
+float findValue(const KeyframeCursor<T>& cursor, const KeyframeTimeline<T>& timeline, unsigned int track, float& derivative) {
+    derivative = evaluateSegmentDerivative(timeline, cursor.index[track], cursor.t[track]) * cursor.rate[track];
+    return evaluateSegment(timeline, cursor.index[track], cursor.t[track]);
+}
+
+// Evaluate every track at once into a pose vector (16 byte aligned)
+template<size_t T>
+void evaluatePose(const KeyframeCursor<T>& cursor, const KeyframeTimeline<T>& timeline, float* pose) {
+    size_t k = 0;
+
+#ifdef KEYFRAME_SIMD
+    // Horner's method, 4 tracks at a time
+    for (; k + 4 <= T; k += 4) {
+        // Gather the active segment of each track, transposed into one vector per coefficient
+        __m128 c0 = _mm_load_ps(timeline.segments[cursor.index[k + 0]].c);
+        __m128 c1 = _mm_load_ps(timeline.segments[cursor.index[k + 1]].c);
+        __m128 c2 = _mm_load_ps(timeline.segments[cursor.index[k + 2]].c);
+        __m128 c3 = _mm_load_ps(timeline.segments[cursor.index[k + 3]].c);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        const __m128 t = _mm_load_ps(cursor.t + k);
+        __m128 v = c3;
+        v = _mm_add_ps(_mm_mul_ps(v, t), c2);
+        v = _mm_add_ps(_mm_mul_ps(v, t), c1);
+        v = _mm_add_ps(_mm_mul_ps(v, t), c0);
+        _mm_store_ps(pose + k, v);
+    }
+#endif
+
+    for (; k < T; k++)
+        pose[k] = evaluateSegment(timeline, cursor.index[k], cursor.t[k]);
+}
+
+// Evaluate every track at once into a pose vector, and its time derivative into a velocity vector (both 16 byte aligned)
+template<size_t T>
+void evaluatePose(const KeyframeCursor<T>& cursor, const KeyframeTimeline<T>& timeline, float* pose, float* velocity) {
+    size_t k = 0;
+
+#ifdef KEYFRAME_SIMD
+    // Horner's method for the value and its derivative, 4 tracks at a time
+    const __m128 two = _mm_set1_ps(2.f);
+    const __m128 three = _mm_set1_ps(3.f);
+    for (; k + 4 <= T; k += 4) {
+        __m128 c0 = _mm_load_ps(timeline.segments[cursor.index[k + 0]].c);
+        __m128 c1 = _mm_load_ps(timeline.segments[cursor.index[k + 1]].c);
+        __m128 c2 = _mm_load_ps(timeline.segments[cursor.index[k + 2]].c);
+        __m128 c3 = _mm_load_ps(timeline.segments[cursor.index[k + 3]].c);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        const __m128 t = _mm_load_ps(cursor.t + k);
+        __m128 v = c3;
+        v = _mm_add_ps(_mm_mul_ps(v, t), c2);
+        v = _mm_add_ps(_mm_mul_ps(v, t), c1);
+        v = _mm_add_ps(_mm_mul_ps(v, t), c0);
+        _mm_store_ps(pose + k, v);
+
+        __m128 d = _mm_mul_ps(_mm_mul_ps(three, c3), t);
+        d = _mm_add_ps(_mm_mul_ps(_mm_add_ps(d, _mm_mul_ps(two, c2)), t), c1);
+        _mm_store_ps(velocity + k, _mm_mul_ps(d, _mm_load_ps(cursor.rate + k)));
+    }
+#endif
+
+    for (; k < T; k++)
+        pose[k] = findValue(cursor, timeline, (unsigned int)k, velocity[k]);
+}
+
+// Tracks that changed since the previous pose, one bit per track, and keep the pose for the next call (both 16 byte aligned)
+// Lets the caller skip uploading unchanged tracks, or drawing at all when nothing changed
+template<size_t T>
+unsigned int poseChanges(const float* pose, float* previous) {
+    static_assert(T <= 32, "Pose changes are a 32 bit mask");
+    unsigned int changed = 0;
+    size_t k = 0;
+
+#ifdef KEYFRAME_SIMD
+    for (; k + 4 <= T; k += 4) {
+        const __m128 v = _mm_load_ps(pose + k);
+        changed |= (unsigned int)_mm_movemask_ps(_mm_cmpneq_ps(v, _mm_load_ps(previous + k))) << k;
+        _mm_store_ps(previous + k, v);
+    }
+#endif
+
+    for (; k < T; k++) {
+        changed |= (unsigned int)(pose[k] != previous[k]) << k;
+        previous[k] = pose[k];
+    }
+    return changed;
+}
+
+// Evaluate tracks at many sorted timestamps at once (sub-frames, or a range of frames for export)
+// Fills a time x track matrix: samples[s * trackCount + j] is tracks[j] at times[s]
+// Each track is walked once alongside the timestamps, 4 timestamps at a time while they share a segment
+template<size_t T>
+void evaluateSamples(const KeyframeTimeline<T>& timeline, const float* times, unsigned int count, const unsigned int* tracks, unsigned int trackCount, float* samples) {
+    if (count == 0)
+        return;
+
+    for (unsigned int j = 0; j < trackCount; j++) {
+        unsigned int k = tracks[j];
+        unsigned int i = findKey(timeline, k, times[0]);
+        unsigned int last = timeline.first[k + 1] - 1;
+        float* out = samples + j;
+        unsigned int s = 0;
+
+#ifdef KEYFRAME_SIMD
+        for (; s + 4 <= count;) {
+            while (i < last && times[s] >= timeline.start[i + 1])
+                i++;
+
+            // Timestamps in different segments are done one by one
+            if (i < last && times[s + 3] >= timeline.start[i + 1]) {
+                out[s * trackCount] = evaluateSegment(timeline, i, segmentTime(timeline, i, times[s]));
+                s++;
+                continue;
+            }
+
+            const float* c = timeline.segments[i].c;
+            __m128 t = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(times + s), _mm_set1_ps(timeline.start[i])), _mm_set1_ps(timeline.invDuration[i]));
+            t = _mm_max_ps(t, _mm_setzero_ps());
+
+            __m128 v = _mm_set1_ps(c[3]);
+            v = _mm_add_ps(_mm_mul_ps(v, t), _mm_set1_ps(c[2]));
+            v = _mm_add_ps(_mm_mul_ps(v, t), _mm_set1_ps(c[1]));
+            v = _mm_add_ps(_mm_mul_ps(v, t), _mm_set1_ps(c[0]));
+
+            alignas(16) float value[4];
+            _mm_store_ps(value, v);
+            for (unsigned int n = 0; n < 4; n++)
+                out[(s + n) * trackCount] = value[n];
+            s += 4;
+        }
+#endif
+
+        for (; s < count; s++) {
+            while (i < last && times[s] >= timeline.start[i + 1])
+                i++;
+            out[s * trackCount] = evaluateSegment(timeline, i, segmentTime(timeline, i, times[s]));
+        }
+    }
+}
+
+// Integral of a track over time, from time 0 (e.g. the scroll position from the speed track)
+// Every segment is a cubic, so its integral is a quartic, without an error or a dependency on the frame rate:
+//   integral(time) = prefix + o * (e0 + o * (e1 + o * (e2 + o * e3))), with o = time - start (in seconds)
+// Held keys (the last one, duplicates) integrate their value linearly, and so does the first key before it starts
+struct KeyframeIntegral {
+    float prefix; // Integral up to the start of the key
+    float e[4];   // Quartic of the segment starting at the key, per second (without the constant)
+};
+
+// Integrate one track into a prefix table, one entry for each of its keys
+template<size_t T>
+void integrateTrack(const KeyframeTimeline<T>& timeline, unsigned int track, KeyframeIntegral* integral) {
+    unsigned int first = timeline.first[track];
+    unsigned int last = timeline.first[track + 1] - 1;
+    double prefix = timeline.segments[first].c[0] * timeline.start[first]; // First value held from time 0
+
+    for (unsigned int i = first; i <= last; i++) {
+        const float* c = timeline.segments[i].c;
+        float rate = timeline.invDuration[i];
+
+        KeyframeIntegral& segment = integral[i - first];
+        segment.prefix = (float)prefix;
+        segment.e[0] = c[0];
+        segment.e[1] = c[1] * rate / 2.f;
+        segment.e[2] = c[2] * rate * rate / 3.f;
+        segment.e[3] = c[3] * rate * rate * rate / 4.f;
+
+        // Whole segment, over t = 0..1
+        if (i < last && rate > 0.f)
+            prefix += (c[0] + c[1] / 2.0 + c[2] / 3.0 + c[3] / 4.0) * (timeline.start[i + 1] - timeline.start[i]);
+    }
+}
+
+// Integral at offset seconds into the segment starting at key i (negative before the first key)
+template<size_t T>
+inline float evaluateIntegral(const KeyframeTimeline<T>& timeline, unsigned int track, const KeyframeIntegral* integral, unsigned int i, float offset) {
+    const KeyframeIntegral& segment = integral[i - timeline.first[track]];
+    const float* e = segment.e;
+    return segment.prefix + (offset > 0.f ? offset * (e[0] + offset * (e[1] + offset * (e[2] + offset * e[3]))) : offset * e[0]);
+}
+
+// Integral of a track at any time, without integrating the frames before it
+template<size_t T>
+float findIntegral(float time, const KeyframeTimeline<T>& timeline, unsigned int track, const KeyframeIntegral* integral) {
+    unsigned int i = findKey(timeline, track, time);
+    return evaluateIntegral(timeline, track, integral, i, time - timeline.start[i]);
+}
+
+// Same by audio sample, on an integer timeline
+template<size_t T>
+float findSampleIntegral(unsigned int sample, const KeyframeTimeline<T>& timeline, unsigned int track, const KeyframeIntegral* integral) {
+    unsigned int i = findSampleKey(timeline, track, sample);
+    return evaluateIntegral(timeline, track, integral, i, float(int(sample - timeline.startSample[i])) * timeline.samplePeriod);
+}
+
+// Same using the segment already found by the cursor (constant time)
+template<size_t T>
+float findSampleIntegral(const KeyframeCursor<T>& cursor, unsigned int sample, const KeyframeTimeline<T>& timeline, unsigned int track, const KeyframeIntegral* integral) {
+    unsigned int i = cursor.index[track];
+    return evaluateIntegral(timeline, track, integral, i, float(int(sample - timeline.startSample[i])) * timeline.samplePeriod);
+}
+
+// Clips: reusable keys of some of the tracks (e.g. a push cycle), compiled once into a timeline of their own,
+// and placed on the main timeline by instances, without expanding them into keys
+// Tracks a clip doesn't key have no keys in its timeline (first[k] == first[k + 1]), and are left alone
+// Clips don't change the scroll position (the integral of the speed keys), and aren't applied with GPU_KEYFRAMES
+template<size_t T>
+struct KeyframeClip {
+    KeyframeTimeline<T> timeline; // Keys of the clip, from time 0
+    float length;                  // Seconds, repeats start over after it
+};
+
+// A clip placed on the timeline
+struct ClipInstance {
+    unsigned int clip;   // Index in the clip library
+    float start;         // Time the clip starts at (seconds)
+    float scale;         // Clip seconds per second (playback speed)
+    float weight;        // Blend weight towards the clip (1 replaces the tracks below)
+    unsigned int repeat; // Times the clip is played back to back
+};
+
+// Compile packed keys of clips, stored back to back (counts[c * T + k] keys for track k of clip c)
+// Each clip's timeline points to its own slice of one shared arena, sized for the keys of every clip
+template<size_t T, typename Count>
+void compileClips(KeyframeClip<T>* clips, unsigned int count, const Count* counts, const float* lengths, const float* stamps, const float* values, const KeyframeTimeline<T>& arena) {
+    unsigned int offset = 0;
+    for (unsigned int c = 0; c < count; c++) {
+        KeyframeTimeline<T>& timeline = clips[c].timeline;
+        timeline.start = arena.start + offset;
+        timeline.invDuration = arena.invDuration + offset;
+        timeline.segments = arena.segments + offset;
+
+        compileTracks(timeline, counts + c * T, stamps + offset, values + offset);
+        clips[c].length = lengths[c];
+        offset += timeline.first[T];
+    }
+}
+
+// Blend every clip instance playing at time into a pose, in order (later instances blend over earlier ones)
+template<size_t T>
+void evaluateClips(float time, const KeyframeClip<T>* clips, const ClipInstance* instances, unsigned int count, float* pose) {
+    for (unsigned int n = 0; n < count; n++) {
+        const ClipInstance& instance = instances[n];
+        const KeyframeClip<T>& clip = clips[instance.clip];
+
+        float local = (time - instance.start) * instance.scale;
+        if (!(local >= 0.f && local < clip.length * instance.repeat))
+            continue;
+
+        // Repeats start over
+        local -= clip.length * float(floorToInt(local / clip.length));
+
+        for (unsigned int k = 0; k < T; k++)
+            if (clip.timeline.first[k] < clip.timeline.first[k + 1])
+                pose[k] += instance.weight * (findValue(local, clip.timeline, k) - pose[k]);
+    }
+}
+
+// Generators: periodic or derived motion (e.g. a body bob, a hip sway, wheel driven motion), added to a track
+// without keys, as a function of an input: the time, the scroll position, or another track of the pose
+//   pose[track] += amplitude * shape(frequency * input + phase), while start <= time < end
+// Like clips, they aren't applied with GPU_KEYFRAMES
+#define GENERATOR_SINE 0   // sin(2 pi x), x in cycles (within 2^22, as floorToInt())
+#define GENERATOR_NOISE 1  // Smooth value noise between -1 and 1, one random value per cycle
+#define GENERATOR_LINEAR 2 // x itself (e.g. a wheel angle from the scroll position)
+
+// Inputs that aren't tracks
+#define GENERATOR_TIME -1   // Seconds
+#define GENERATOR_SCROLL -2 // Integral of the speed
+
+struct KeyframeGenerator {
+    int track;       // Track the generator is added to
+    int type;        // GENERATOR_SINE, GENERATOR_NOISE or GENERATOR_LINEAR
+    int input;       // Track driving the generator, GENERATOR_TIME or GENERATOR_SCROLL
+    float amplitude;
+    float frequency; // Cycles per unit of input
+    float phase;     // Cycles
+    float start;     // Seconds the generator is active from,
+    float end;       // and until
+};
+
+// sin(2 pi x) within about 0.001, without the CRT: a parabola per half cycle, refined
+inline float generatorSine(float x) {
+    x -= float(floorToInt(x + 0.5f)); // -0.5..0.5 cycles
+    float y = 8.f * x - 16.f * x * (x < 0.f ? -x : x);
+    return y + 0.225f * (y * (y < 0.f ? -y : y) - y);
+}
+
+// Random value between -1 and 1 for every cycle (integer hash), per seed
+inline float generatorHash(int cycle, int seed) {
+    unsigned int n = (unsigned int)cycle * 374761393u + (unsigned int)seed * 668265263u;
+    n = (n ^ (n >> 13)) * 1274126177u;
+    return float(int((n ^ (n >> 16)) & 0xFFFF)) * (2.f / 65535.f) - 1.f;
+}
+
+// Random values between cycles, smoothstep interpolated
+inline float generatorNoise(float x, int seed) {
+    int cycle = floorToInt(x);
+    float t = x - float(cycle);
+    float a = generatorHash(cycle, seed);
+    return a + (generatorHash(cycle + 1, seed) - a) * t * t * (3.f - 2.f * t);
+}
+
+// Add every generator active at time to a pose, in order (a generator can be driven by a track an earlier one changed)
+inline void evaluateGenerators(float time, float scroll, const KeyframeGenerator* generators, unsigned int count, float* pose) {
+    for (unsigned int n = 0; n < count; n++) {
+        const KeyframeGenerator& generator = generators[n];
+        if (!(time >= generator.start && time < generator.end))
+            continue;
+
+        float input = generator.input == GENERATOR_TIME ? time : generator.input == GENERATOR_SCROLL ? scroll : pose[generator.input];
+        float x = generator.frequency * input + generator.phase;
 
-    // Fallback to last keyframe
-    return keys[N - 1];
+        float shape = generator.type == GENERATOR_SINE ? generatorSine(x) : generator.type == GENERATOR_NOISE ? generatorNoise(x, generator.track) : x;
+        pose[generator.track] += generator.amplitude * shape;
+    }
 }
 
 #endif //KEYFRAMES_H_
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include <math.h>
 #include "glext.h"
 #include "shaders/fragmentShader.inl"
+#ifdef GPU_KEYFRAMES
+    #include "shaders/keyframes.inl"
+#endif
 #include "../assets/music/output/4klang.h"
 #include "audio.h"
 
@@ -26,6 +29,9 @@
     #include <stdio.h>
     #include <cassert> 
     #include <filesystem>
+
+    #include "keyframe_watcher.h"
+    #include "keyframe_link.h"
 #endif
 
 // OpenGL definitions
@@ -60,12 +66,72 @@
 #define glUseProgramStages ((PFNGLUSEPROGRAMSTAGESPROC)wglGetProcAddress("glUseProgramStages"))
 #define glGenProgramPipelines ((PFNGLGENPROGRAMPIPELINESPROC)wglGetProcAddress("glGenProgramPipelines"))
 #define glBindProgramPipeline ((PFNGLBINDPROGRAMPIPELINEPROC)wglGetProcAddress("glBindProgramPipeline"))
+#define glGenBuffers ((PFNGLGENBUFFERSPROC)wglGetProcAddress("glGenBuffers"))
+#define glBindBufferBase ((PFNGLBINDBUFFERBASEPROC)wglGetProcAddress("glBindBufferBase"))
+#define glBufferData ((PFNGLBUFFERDATAPROC)wglGetProcAddress("glBufferData"))
+#define glDispatchCompute ((PFNGLDISPATCHCOMPUTEPROC)wglGetProcAddress("glDispatchCompute"))
+#define glMemoryBarrier ((PFNGLMEMORYBARRIERPROC)wglGetProcAddress("glMemoryBarrier"))
 
 
 #ifdef DEBUG
 static bool isPaused = false;
 #endif
 
+// Draw the next frame even if the pose didn't change (first frame, reload, resize, repaint)
+static bool redraw = true;
+
+// Any of count tracks from track changed since the frame on screen
+#define CHANGED(track, count) (changed & (((1u << (count)) - 1) << (track)))
+
+#ifndef GPU_KEYFRAMES
+// Shader uniform of every track (0 for none), from the track list: the tracks of a vector uniform share it
+static const char* const trackUniforms[TRACK_COUNT] = {
+#define TRACK_UNIFORM(id, name, uniform) uniform,
+    TRACK_LIST(TRACK_UNIFORM)
+#undef TRACK_UNIFORM
+};
+
+// Uniform setters by vector size
+static const char* const uniformSetters[] = { "glUniform1fv", "glUniform2fv", "glUniform3fv", "glUniform4fv" };
+#endif
+
+#ifdef GPU_KEYFRAMES
+// Buffers of the keyframe compute shader: first key per track, timestamps, reciprocal durations, segments, pose
+static GLuint keyframeBuffers[5];
+
+// Upload the compiled keyframes, only needed when they are (re)loaded
+static void uploadKeyframes() {
+    const GLsizeiptr keyCount = keyframes.first[TRACK_COUNT];
+    const void* data[] = { keyframes.first, keyframes.start, keyframes.invDuration, keyframes.segments, nullptr };
+    const GLsizeiptr size[] = {
+        sizeof(keyframes.first),
+        keyCount * (GLsizeiptr)sizeof(float),
+        keyCount * (GLsizeiptr)sizeof(float),
+        keyCount * (GLsizeiptr)sizeof(KeyframeSegment),
+        POSE_STRIDE * sizeof(float)
+    };
+
+    for (int i = 0; i < 5; i++) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, keyframeBuffers[i]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, size[i], data[i], data[i] ? GL_STATIC_DRAW : GL_DYNAMIC_COPY);
+    }
+}
+#endif
+
+#ifdef DEBUG
+// Use reloaded keyframe data once the worker has it ready (between frames), and continue from the time saved by the editor
+static void publishReloadedKeyframes() {
+    float time_cursor;
+    if (!publishKeyframes(time_cursor))
+        return;
+#ifdef GPU_KEYFRAMES
+    uploadKeyframes();
+#endif
+    seekAudio(time_cursor);
+    redraw = true;
+}
+#endif
+
 
 // Floating point support flag for MSVC
 #ifdef __cplusplus
@@ -146,9 +212,8 @@ static LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT msg, WPARAM wParam, LPAR
                     return 0;
 
                 case 'R':
-                    // Reload keyframe data
-                    float time_cursor = loadKeyframesFromJSON("../assets/keyframes/keyframes.json");
-                    seekAudio(time_cursor);
+                    // Reload keyframe data (on the worker thread)
+                    requestKeyframeReload("../assets/keyframes/keyframes.json");
                     return 0;
             }
             break;
@@ -158,8 +223,15 @@ static LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT msg, WPARAM wParam, LPAR
             int width = LOWORD(lParam);
             int height = HIWORD(lParam);
             glViewport(0, 0, width, height);
+            redraw = true;
             return 0;
         }
+
+        case WM_PAINT:
+            // Redraw when the window is uncovered or restored, even while paused
+            redraw = true;
+            ValidateRect(hwnd, nullptr);
+            return 0;
     }
 
     // Let Windows handle any unprocessed messages
@@ -282,7 +354,15 @@ void entrypoint(void) {
 #endif
 
     // Compile GLSL fragment shader
+#ifdef GPU_KEYFRAMES
+    // Insert the GPU_KEYFRAMES define after the #version line, the pose is then read from a buffer (at the TRACK_ indices)
+    const char* fragmentShaderBody = fragmentShader_frag;
+    while (*fragmentShaderBody++ != '\n');
+    const char* fragmentShaderSources[] = { "#version 430\n#define GPU_KEYFRAMES\n", trackDefines.text, fragmentShaderBody };
+    const unsigned int shaderProgram = glCreateShaderProgramv(GL_FRAGMENT_SHADER, 3, fragmentShaderSources);
+#else
     const unsigned int shaderProgram = glCreateShaderProgramv(GL_FRAGMENT_SHADER, 1, &fragmentShader_frag);
+#endif
 
 #ifdef DEBUG
     // Check if the shader program linked successfully.
@@ -298,27 +378,96 @@ void entrypoint(void) {
 
 
 #ifdef DEBUG
-    // Prepare keyframe data file for auto-reloading
+    // Watch the keyframe data file for auto-reloading (on a background thread)
     const std::string keyframesPath = "../assets/keyframes/keyframes.json";
-    std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(keyframesPath);
-    auto lastCheckTime = std::chrono::steady_clock::now();
+    static FileWatcher keyframeWatcher;
+    startWatcher(keyframeWatcher, keyframesPath);
+
+    // Take keyframes pushed by the editor over shared memory
+    static KeyframeLink keyframeLink;
+    if (!startKeyframeLink(keyframeLink))
+        printf("Keyframe link not available, the editor's pushes are ignored\n");
 
     printf("interpolation type: %d", sizeof(enum Interpolation));
     printf("keyframe: %d", sizeof(float));
 
     // Load it fot the first time
     loadKeyframesFromJSON(keyframesPath);
+#else
+    #if defined(CONSTEXPR_KEYFRAMES)
+    // Already compiled during the build
+    #elif defined(ENCODED_KEYFRAMES)
+    // Decode the keys of every track, and compile them into polynomial segments
+    decodeKeyframes(keyframes, keyframeCodec, keyDecodedValues);
+    #elif defined(SPARSE_KEYFRAMES)
+    // Look up the timestamp of every key in place, and compile the packed keys of every track into polynomial segments
+    for (unsigned int i = 0; i < KEY_TOTAL; i++)
+        keyStart[i] = sharedKeyTimes[trackKeyTimes[i]];
+    compileTracks(keyframes, trackKeyCounts, keyStart, trackKeyValues);
+    #else
+    // Compile the packed keyframe data into polynomial segments
+    compileKeyframes(keyframes, timestamps, keyframeTable);
+    #endif
+
+    // Integrate the speed into the scroll position
+    integrateTrack(keyframes, TRACK_SPEED, speedIntegral);
+
+    #ifdef KEYFRAME_CLIPS
+    // Compile every clip once, however many times it is placed
+    compileClips(clipLibrary, CLIP_COUNT, &clipKeyCounts[0][0], clipLengths, clipKeyTimes, clipKeyValues, clipArena);
+    #endif
+
+    #ifdef BAKE_KEYFRAMES
+    // Sample every track into the pose table
+    bakeKeyframes(bakedKeyframes, keyframes, nullptr);
+    #endif
+#endif
+
+#ifdef GPU_KEYFRAMES
+    // Compile GLSL keyframe compute shader, and upload keyframe data
+    const unsigned int keyframeProgram = glCreateShaderProgramv(GL_COMPUTE_SHADER, 1, &keyframes_comp);
+
+#ifdef DEBUG
+    glGetProgramiv(keyframeProgram, GL_LINK_STATUS, &result);
+    if (!result) {
+        char error[1024];
+        glGetProgramInfoLog(keyframeProgram, 1024, nullptr, (char*)error);
+        MessageBox(windowHandle, error, "Error", MB_OK);
+        return 0;
+    }
+#endif
+
+    glGenBuffers(5, keyframeBuffers);
+    uploadKeyframes();
 #endif
 
     // Activate fragment shader
     glUseProgram(shaderProgram);
 
+#ifndef GPU_KEYFRAMES
+    // Uniform locations of the tracks, looked up once (-1 for tracks without one)
+    static GLint uniformLocations[TRACK_COUNT];
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        uniformLocations[k] = trackUniforms[k] ? glGetUniformLocation(shaderProgram, trackUniforms[k]) : -1;
+#ifdef DEBUG
+        if (trackUniforms[k] && uniformLocations[k] < 0)
+            printf("Track %s: uniform %s not in the shader\n", trackNames[k], trackUniforms[k]);
+#endif
+    }
+#endif
+
     // Start audio rendering thread
     initAudio();
 
     // Main loop
     MSG message;
-    float time=0.0f, new_time, scroll=0.0f;
+    DWORD position, shownPosition = 0; // Audio samples
+    float scroll = 0.0f, shownScroll = 0.0f;
+    alignas(16) static float pose[POSE_STRIDE];
+    alignas(16) static float shownPose[POSE_STRIDE]; // Pose of the frame on screen
+#if !defined(GPU_KEYFRAMES) && !defined(BAKE_KEYFRAMES)
+    static KeyframeCursor<TRACK_COUNT> cursor;
+#endif
     do {
         
         // Message handling
@@ -337,90 +486,105 @@ void entrypoint(void) {
         PeekMessage(&message, windowHandle, 0, 0, PM_REMOVE);
 #endif
 
-        // Auto-reload keyframe data file
+        // Auto-reload keyframe data file (or compile what the editor pushed) on the worker thread, and use it once it is ready
 #ifdef DEBUG
-        auto now = std::chrono::steady_clock::now();
-        if (now - lastCheckTime > std::chrono::milliseconds(500)) {
-            lastCheckTime = now;
-
-            auto currentWriteTime = std::filesystem::last_write_time(keyframesPath);
-            if (currentWriteTime != lastWriteTime) {
-                lastWriteTime = currentWriteTime;
-                float time_cursor = loadKeyframesFromJSON(keyframesPath);
-                seekAudio(time_cursor);
-            }
-        }
+        if (fileChanged(keyframeWatcher))
+            requestKeyframeReload(keyframesPath);
+        pushKeyframes(keyframeLink);
+        publishReloadedKeyframes();
 #endif
 
-        // Update time
-        new_time = GetAudioPlaybackTime();
-        scroll += (new_time - time) * findValue(time, speed);
-        time = new_time;
+        // Update time, in audio samples (keys are found by comparing integers)
+        position = GetAudioPlaybackSample();
 
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_scroll), scroll);
+        // Nothing moves while paused (or at the end), until a reload, resize or repaint forces a redraw
+        unsigned int changed = redraw ? ~0u : 0u;
+        if (position != shownPosition || redraw) {
+            shownPosition = position;
 
-        // Update positions
-        // Camera
-        glUniform3f(glGetUniformLocation(shaderProgram, VAR_camera),
-            findValue(time, camera_x),
-            findValue(time, camera_y),
-            findValue(time, camera_z));
-        
-        glUniform3f(glGetUniformLocation(shaderProgram, VAR_target),
-            findValue(time, target_x),
-            findValue(time, target_y),
-            findValue(time, target_z));
-
-        // Board
-        glUniform3f(glGetUniformLocation(shaderProgram, VAR_board_euler),
-            findValue(time, boardEuler_x),
-            findValue(time, boardEuler_y),
-            findValue(time, boardEuler_z));
-
-        glUniform3f(glGetUniformLocation(shaderProgram, VAR_board_offset),
-            findValue(time, boardPos_x),
-            findValue(time, boardPos_y),
-            findValue(time, boardPos_z));
-
-        // Body
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_body_twist), findValue(time, body_twist));
-
-        glUniform3f(glGetUniformLocation(shaderProgram, VAR_body_offset),
-            findValue(time, bodyHipPosition_x),
-            findValue(time, bodyHipPosition_y),
-            findValue(time, bodyHipPosition_z));
-
-        // Legs
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_hip_rotation_r), findValue(time, hip_rotation_r));
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_hip_flexion_r), findValue(time, hip_flexion_r));
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_hip_abduction_r), findValue(time, hip_abduction_r));
-        
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_knee_flexion_r), findValue(time, knee_flexion_r));
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_ankle_flexion_r), findValue(time, ankle_flexion_r));
+#if defined(GPU_KEYFRAMES)
+            // The compute shader evaluates the pose for the fragment shader, only the scroll position is needed on the CPU
+            scroll = findSampleIntegral(position, keyframes, TRACK_SPEED, speedIntegral);
+            changed = ~0u;
 
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_hip_rotation_l), findValue(time, hip_rotation_l));
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_hip_flexion_l), findValue(time, hip_flexion_l));
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_hip_abduction_l), findValue(time, hip_abduction_l));
+            glUseProgram(keyframeProgram);
+            glUniform1f(0, float(position) * (1.0f / SAMPLE_RATE));
+            glDispatchCompute((TRACK_COUNT + 31) / 32, 1, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            glUseProgram(shaderProgram);
+#else
+    #if defined(BAKE_KEYFRAMES)
+            // Look up the pose in the baked table
+            samplePose(bakedKeyframes, position, pose, TRACK_COUNT, BAKE_LERP);
+            scroll = findSampleIntegral(position, keyframes, TRACK_SPEED, speedIntegral);
+    #else
+            // Move the cursor of every track, then evaluate them together
+            updateCursorSample(cursor, position, keyframes);
+        #if defined(CONSTEXPR_KEYFRAMES) && !defined(DEBUG)
+            evaluateConstexprPose<constexprKeyframes>(cursor, pose);
+        #else
+            evaluatePose(cursor, keyframes, pose);
+        #endif
+            scroll = findSampleIntegral(cursor, position, keyframes, TRACK_SPEED, speedIntegral);
+    #endif
+
+    #if defined(DEBUG) || defined(KEYFRAME_CLIPS)
+            // Blend the clips playing at this time over the tracks
+            evaluateClips(float(position) * (1.0f / SAMPLE_RATE), clipLibrary, clipInstances, clipInstanceCount, pose);
+    #endif
+
+    #if defined(DEBUG) || defined(KEYFRAME_GENERATORS)
+            // Add the periodic and derived motion
+            evaluateGenerators(float(position) * (1.0f / SAMPLE_RATE), scroll, generators, generatorCount, pose);
+    #endif
+
+            // Holds and STEP segments leave tracks unchanged
+            changed |= poseChanges<TRACK_COUNT>(pose, shownPose);
+#endif
+        }
 
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_knee_flexion_l), findValue(time, knee_flexion_l));
-        glUniform1f(glGetUniformLocation(shaderProgram, VAR_ankle_flexion_l), findValue(time, ankle_flexion_l));
+        // Scroll position is the integral of the speed, so it doesn't depend on the frames before
+        if (scroll != shownScroll || redraw) {
+            shownScroll = scroll;
+            changed |= 1u << TRACK_SPEED; // Scroll is the integral of the speed
+            glUniform1f(glGetUniformLocation(shaderProgram, VAR_scroll), scroll);
+        }
 
-        // Draw fullscreen
-        glRects(-1, -1, 1, 1);
+#ifndef GPU_KEYFRAMES
+        // Update the uniforms of the tracks that changed since the last frame, one for each run of tracks sharing it
+        for (unsigned int k = 0, size; k < TRACK_COUNT; k += size) {
+            for (size = 1; k + size < TRACK_COUNT && uniformLocations[k + size] == uniformLocations[k]; size++)
+                ;
+            if (uniformLocations[k] >= 0 && CHANGED(k, size))
+                ((PFNGLUNIFORM1FVPROC)wglGetProcAddress(uniformSetters[size - 1]))(uniformLocations[k], 1, pose + k);
+        }
+#endif
+
+        // Draw and present only when something changed, otherwise the last frame stays on screen
+        if (changed) {
+            redraw = false;
 
-        // Present the frame
+            // Draw fullscreen
+            glRects(-1, -1, 1, 1);
+
+            // Present the frame
 #ifdef DEBUG
-        SwapBuffers(deviceContext); // Cleaner
+            SwapBuffers(deviceContext); // Cleaner
 #else
-        wglSwapLayerBuffers(deviceContext, WGL_SWAP_MAIN_PLANE); // Smaller
+            wglSwapLayerBuffers(deviceContext, WGL_SWAP_MAIN_PLANE); // Smaller
 #endif
+        }
         
         // Frame cap (approx. 60 FPS)
         Sleep(16);
 
-    } while ((message.message != WM_KEYDOWN || message.wParam != VK_ESCAPE) && time < 76.6);
+    } while ((message.message != WM_KEYDOWN || message.wParam != VK_ESCAPE) && position < DWORD(76.6 * SAMPLE_RATE));
 
 #ifdef DEBUG
+    stopWatcher(keyframeWatcher);
+    stopKeyframeLink(keyframeLink);
+    stopKeyframeReloads();
+
     // If a valid OpenGL rendering context exists, release it
     if (glRenderContext) {
         wglMakeCurrent(0, 0); // Detach the rendering context
@@ -77,6 +77,36 @@ const float i_PALM_HEIGHT = 5.0;
 const float i_PALM_SIZE = 2.0;
 
 
+#ifdef GPU_KEYFRAMES
+// Pose evaluated by the keyframe compute shader (keyframes.comp), indexed by TRACK_ defines generated from the track list
+layout(std430, binding = 4) readonly buffer Pose { float pose[]; };
+
+vec3 camera, target, board_euler, board_offset, body_offset;
+float body_twist;
+float hip_rotation_r, hip_flexion_r, hip_abduction_r, knee_flexion_r, ankle_flexion_r;
+float hip_rotation_l, hip_flexion_l, hip_abduction_l, knee_flexion_l, ankle_flexion_l;
+
+void loadPose() {
+    camera = vec3(pose[TRACK_CAMERA_X], pose[TRACK_CAMERA_Y], pose[TRACK_CAMERA_Z]);
+    target = vec3(pose[TRACK_TARGET_X], pose[TRACK_TARGET_Y], pose[TRACK_TARGET_Z]);
+    board_euler = vec3(pose[TRACK_BOARD_EULER_X], pose[TRACK_BOARD_EULER_Y], pose[TRACK_BOARD_EULER_Z]);
+    board_offset = vec3(pose[TRACK_BOARD_POS_X], pose[TRACK_BOARD_POS_Y], pose[TRACK_BOARD_POS_Z]);
+    body_twist = pose[TRACK_BODY_TWIST];
+    body_offset = vec3(pose[TRACK_BODY_HIP_POSITION_X], pose[TRACK_BODY_HIP_POSITION_Y], pose[TRACK_BODY_HIP_POSITION_Z]);
+
+    hip_rotation_r = pose[TRACK_HIP_ROTATION_R];
+    hip_flexion_r = pose[TRACK_HIP_FLEXION_R];
+    hip_abduction_r = pose[TRACK_HIP_ABDUCTION_R];
+    knee_flexion_r = pose[TRACK_KNEE_FLEXION_R];
+    ankle_flexion_r = pose[TRACK_ANKLE_FLEXION_R];
+
+    hip_rotation_l = pose[TRACK_HIP_ROTATION_L];
+    hip_flexion_l = pose[TRACK_HIP_FLEXION_L];
+    hip_abduction_l = pose[TRACK_HIP_ABDUCTION_L];
+    knee_flexion_l = pose[TRACK_KNEE_FLEXION_L];
+    ankle_flexion_l = pose[TRACK_ANKLE_FLEXION_L];
+}
+#else
 // Camera angles
 uniform vec3 camera;
 uniform vec3 target;
@@ -122,6 +152,7 @@ uniform float hip_flexion_l;
 uniform float hip_abduction_l;
 uniform float knee_flexion_l;
 uniform float ankle_flexion_l;
+#endif
 
 // Scroll scenery
 uniform float scroll;
@@ -531,6 +562,10 @@ void addBumps(vec3 position, inout vec3 normal, float size, float strength) {
 
 // Entry Point
 void main() {
+#ifdef GPU_KEYFRAMES
+    loadPose();
+#endif
+
     // Pixel coordinates (from -1 to 1)
     vec2 uv = (2.0*floor(gl_FragCoord.xy)-vec2(i_WIDTH, i_HEIGHT))/i_WIDTH;
     
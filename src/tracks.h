@@ -0,0 +1,174 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+#ifndef TRACKS_H_
+#define TRACKS_H_
+
+#include <stddef.h>
+
+// Every track of a pose, declared once: the Track enum, the names in the .json file (and their lookup), the shader
+// uniforms the pose is uploaded to, and the indices the shader reads the pose at with GPU_KEYFRAMES are all generated
+// from this list
+// Tracks are in the same order as the editor's track list (and the release keyframe table), the tracks of a vector
+// uniform are contiguous, so a pose can be uploaded to the shader directly
+// TRACK(id, name, uniform): uniform is the uniform's name in fragmentShader.inl (VAR_...), or 0 for no uniform
+// Adding a track is one line here, and the uniform in fragmentShader.frag (GLSL can't include this list, debug builds
+// report uniforms missing from the shader), read in its loadPose() at TRACK_<ID> for GPU_KEYFRAMES
+#define TRACK_LIST(TRACK) \
+    TRACK(CAMERA_X, camera_x, VAR_camera) \
+    TRACK(CAMERA_Y, camera_y, VAR_camera) \
+    TRACK(CAMERA_Z, camera_z, VAR_camera) \
+    \
+    TRACK(TARGET_X, target_x, VAR_target) \
+    TRACK(TARGET_Y, target_y, VAR_target) \
+    TRACK(TARGET_Z, target_z, VAR_target) \
+    \
+    TRACK(SPEED, speed, 0) /* The shader gets its integral (scroll) */ \
+    \
+    TRACK(BOARD_EULER_X, boardEuler_x, VAR_board_euler) \
+    TRACK(BOARD_EULER_Y, boardEuler_y, VAR_board_euler) \
+    TRACK(BOARD_EULER_Z, boardEuler_z, VAR_board_euler) \
+    \
+    TRACK(BOARD_POS_X, boardPos_x, VAR_board_offset) \
+    TRACK(BOARD_POS_Y, boardPos_y, VAR_board_offset) \
+    TRACK(BOARD_POS_Z, boardPos_z, VAR_board_offset) \
+    \
+    TRACK(BODY_TWIST, body_twist, VAR_body_twist) \
+    \
+    TRACK(BODY_HIP_POSITION_X, bodyHipPosition_x, VAR_body_offset) \
+    TRACK(BODY_HIP_POSITION_Y, bodyHipPosition_y, VAR_body_offset) \
+    TRACK(BODY_HIP_POSITION_Z, bodyHipPosition_z, VAR_body_offset) \
+    \
+    TRACK(HIP_ROTATION_R, hip_rotation_r, VAR_hip_rotation_r) \
+    TRACK(HIP_FLEXION_R, hip_flexion_r, VAR_hip_flexion_r) \
+    TRACK(HIP_ABDUCTION_R, hip_abduction_r, VAR_hip_abduction_r) \
+    \
+    TRACK(KNEE_FLEXION_R, knee_flexion_r, VAR_knee_flexion_r) \
+    TRACK(ANKLE_FLEXION_R, ankle_flexion_r, VAR_ankle_flexion_r) \
+    \
+    TRACK(HIP_ROTATION_L, hip_rotation_l, VAR_hip_rotation_l) \
+    TRACK(HIP_FLEXION_L, hip_flexion_l, VAR_hip_flexion_l) \
+    TRACK(HIP_ABDUCTION_L, hip_abduction_l, VAR_hip_abduction_l) \
+    \
+    TRACK(KNEE_FLEXION_L, knee_flexion_l, VAR_knee_flexion_l) \
+    TRACK(ANKLE_FLEXION_L, ankle_flexion_l, VAR_ankle_flexion_l)
+
+// Tracks of a pose
+enum Track {
+    TRACK_TIMESTAMPS = -1, // Time of each keyframe, not interpolated
+
+#define TRACK_ENUM(id, name, uniform) TRACK_##id,
+    TRACK_LIST(TRACK_ENUM)
+#undef TRACK_ENUM
+
+    TRACK_COUNT
+};
+
+// Names in the .json file, indexed by track + 1 (the timestamps first)
+constexpr const char* trackKeys[TRACK_COUNT + 1] = {
+    "timestamps",
+#define TRACK_NAME(id, name, uniform) #name,
+    TRACK_LIST(TRACK_NAME)
+#undef TRACK_NAME
+};
+
+// Names of the tracks, in order
+constexpr const char* const* trackNames = trackKeys + 1;
+
+// Name lookup without hashing strings at runtime into a container: the compiler picks a seed for which every name
+// hashes to its own slot of a small table, so a lookup is one hash and one compare (unknown names fail the compare)
+#define TRACK_HASH_SIZE 128
+
+struct TrackLookup {
+    unsigned int seed;
+    unsigned char slots[TRACK_HASH_SIZE]; // Index in trackKeys + 1 of the name in each slot, 0 if none
+};
+
+constexpr size_t trackNameLength(const char* name) {
+    size_t length = 0;
+    while (name[length])
+        length++;
+    return length;
+}
+
+// FNV-1a, from a seed
+constexpr unsigned int trackHash(const char* name, size_t length, unsigned int seed) {
+    unsigned int hash = seed;
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    return (hash ^ (hash >> 16)) & (TRACK_HASH_SIZE - 1);
+}
+
+constexpr TrackLookup buildTrackLookup() {
+    for (unsigned int seed = 2166136261u;; seed++) {
+        TrackLookup lookup = { seed, {} };
+        bool collision = false;
+        for (int i = 0; i < TRACK_COUNT + 1 && !collision; i++) {
+            unsigned char& slot = lookup.slots[trackHash(trackKeys[i], trackNameLength(trackKeys[i]), seed)];
+            collision = slot != 0;
+            slot = (unsigned char)(i + 1);
+        }
+        if (!collision)
+            return lookup;
+    }
+}
+
+constexpr TrackLookup trackLookup = buildTrackLookup();
+
+// Track of a name (TRACK_TIMESTAMPS for the timestamps), or TRACK_COUNT for an unknown one
+constexpr int findTrack(const char* name, size_t length) {
+    unsigned int slot = trackLookup.slots[trackHash(name, length, trackLookup.seed)];
+    if (!slot)
+        return TRACK_COUNT;
+
+    const char* key = trackKeys[slot - 1];
+    for (size_t i = 0; i < length; i++)
+        if (key[i] != name[i])
+            return TRACK_COUNT;
+    return key[length] ? TRACK_COUNT : int(slot) - 2;
+}
+
+static_assert(findTrack("timestamps", 10) == TRACK_TIMESTAMPS && findTrack("camera_x", 8) == TRACK_CAMERA_X &&
+    findTrack("ankle_flexion_l", 15) == TRACK_ANKLE_FLEXION_L && findTrack("camera", 6) == TRACK_COUNT, "Track name lookup");
+
+// The track indices for shaders reading the pose from a buffer (GLSL can't include this list): "#define TRACK_<ID> <index>"
+// lines the compiler builds, inserted into the shader source after its #version line
+constexpr const char* trackIds[TRACK_COUNT] = {
+#define TRACK_ID(id, name, uniform) #id,
+    TRACK_LIST(TRACK_ID)
+#undef TRACK_ID
+};
+
+// Writes the defines to text (if not null), returns their length
+constexpr size_t writeTrackDefines(char* text) {
+    size_t length = 0;
+    auto put = [&](const char* string) {
+        for (; *string; string++, length++)
+            if (text)
+                text[length] = *string;
+    };
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        const char index[] = { char('0' + k / 10), char('0' + k % 10), '\n', 0 };
+        put("#define TRACK_");
+        put(trackIds[k]);
+        put(" ");
+        put(index + (k < 10));
+    }
+    return length;
+}
+
+struct TrackDefines {
+    char text[writeTrackDefines(nullptr) + 1];
+};
+
+constexpr TrackDefines buildTrackDefines() {
+    TrackDefines defines = {};
+    writeTrackDefines(defines.text);
+    return defines;
+}
+
+constexpr TrackDefines trackDefines = buildTrackDefines();
+
+static_assert(TRACK_COUNT <= 100, "Track defines have two digit indices");
+
+#endif // TRACKS_H_
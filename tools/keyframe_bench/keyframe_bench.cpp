@@ -0,0 +1,786 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+// Keyframe engine benchmark and correctness harness
+//
+// Builds on Linux (or any platform with a C++20 compiler), without Win32:
+//   g++ -std=c++20 -O2 -DDEBUG -o keyframe_bench keyframe_bench.cpp
+//
+// Usage:
+//   keyframe_bench [keyframes.json] [results.json]
+//
+// Measures the cost of findValue() and of evaluating a full pose, for the given keyframe file and for
+// synthetic timelines with 1k to 100k keys per track. Every evaluation is also checked against a
+// double precision reference, covering all interpolation modes and the packed low-bit mode encoding,
+// and so are integrals (against Simpson's rule) and the same keys snapped to the integer timeline
+// (KEY_TICK with the song defines, 735 samples at 44.1 kHz without them).
+// Results are written as JSON, the exit code is non-zero if any check failed.
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../src/keyframes.h"
+#include "../../src/keyframe_loader.h"
+
+// Source keys of one track, in double precision
+struct ReferenceTrack {
+    std::vector<double> stamps;
+    std::vector<double> values;
+    std::vector<int> modes;
+};
+
+// A timeline to benchmark: reference keys and their compiled form
+struct Timeline {
+    std::string name;
+    ReferenceTrack tracks[TRACK_COUNT];
+    double duration = 0.0;
+
+    std::vector<float> start;
+    std::vector<float> invDuration;
+    std::vector<KeyframeSegment> segments;
+    std::vector<unsigned int> startSample; // Integer timelines only
+    KeyframeTimeline<TRACK_COUNT> compiled = {};
+};
+
+// Audio samples per key tick and seconds per sample of the integer timeline, 60 Hz at 44.1 kHz without the song defines
+#ifdef KEY_TICK
+static const unsigned int keyTick = KEY_TICK;
+static const float samplePeriod = 1.f / SAMPLE_RATE;
+#else
+static const unsigned int keyTick = 735;
+static const float samplePeriod = 1.f / 44100;
+#endif
+
+// Pack an interpolation mode into the last 4 bits of a value, like the loader does
+static float packValue(double value, int mode) {
+    float packed = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &packed, sizeof(bits));
+    bits = (bits & ~0xFu) | (0xF & mode);
+    memcpy(&packed, &bits, sizeof(bits));
+    return packed;
+}
+
+// Double precision blend weight of each interpolation type (unknown types are smoothstep)
+static double referenceWeight(int mode, double t) {
+    switch (mode) {
+        case STEP: return 0.0;
+        case LINEAR: return t;
+        case QUADRATIC_IN: return t * t;
+        case QUADRATIC_OUT: return 2.0 * t - t * t;
+        case CUBIC_IN: return t * t * t;
+        case CUBIC_OUT: return 1.0 - (1.0 - t) * (1.0 - t) * (1.0 - t);
+        default: return t * t * (3.0 - 2.0 * t);
+    }
+}
+
+// Double precision derivative of the blend weight of each interpolation type
+static double referenceWeightDerivative(int mode, double t) {
+    switch (mode) {
+        case STEP: return 0.0;
+        case LINEAR: return 1.0;
+        case QUADRATIC_IN: return 2.0 * t;
+        case QUADRATIC_OUT: return 2.0 - 2.0 * t;
+        case CUBIC_IN: return 3.0 * t * t;
+        case CUBIC_OUT: return 3.0 * (1.0 - t) * (1.0 - t);
+        default: return 6.0 * t * (1.0 - t);
+    }
+}
+
+// Last key of a track at or before time, or its first key
+static size_t referenceKey(const ReferenceTrack& track, double time) {
+    size_t i = std::upper_bound(track.stamps.begin(), track.stamps.end(), time) - track.stamps.begin();
+    return i ? i - 1 : 0;
+}
+
+// Expected value of the segment starting at key i, and the error a float evaluation may have at that point
+static double referenceSegment(const ReferenceTrack& track, size_t i, double time, double& tolerance, double& derivative, double& derivativeTolerance) {
+    const std::vector<double>& stamps = track.stamps;
+
+    double a = track.values[i];
+    derivative = 0.0;
+    derivativeTolerance = 0.0;
+    if (i + 1 >= stamps.size() || time < stamps[i]) {
+        tolerance = 32.0 * FLT_EPSILON * (1.0 + fabs(a));
+        return a;
+    }
+
+    double b = track.values[i + 1];
+    double duration = stamps[i + 1] - stamps[i];
+    double t = (time - stamps[i]) / duration;
+
+    // Float rounding of the value (including 4 packed mode bits), and of t, times the steepest slope (3)
+    double valueError = 32.0 * FLT_EPSILON * (1.0 + fabs(a) + fabs(b));
+    double timeError = 8.0 * FLT_EPSILON * (fabs(time) + fabs(stamps[i]) + duration) / duration;
+    tolerance = valueError + 3.0 * fabs(b - a) * timeError;
+
+    int mode = track.modes[i + 1];
+    if (mode == SPLINE) {
+        // Cubic Hermite segment, with Catmull-Rom tangents from the neighbouring keys (one sided at the ends)
+        auto tangent = [&](size_t j) {
+            size_t previous = j > 0 ? j - 1 : j;
+            size_t next = j + 1 < stamps.size() ? j + 1 : j;
+            return (track.values[next] - track.values[previous]) / (stamps[next] - stamps[previous]) * duration;
+        };
+        double m0 = tangent(i);
+        double m1 = tangent(i + 1);
+        double c2 = 3.0 * (b - a) - 2.0 * m0 - m1;
+        double c3 = m0 + m1 - 2.0 * (b - a);
+
+        // Tangents add to the magnitude of the coefficients, and to the steepest slope
+        double scale = fabs(a) + fabs(b) + fabs(m0) + fabs(m1);
+        double slope = 3.0 * fabs(b - a) + 2.0 * (fabs(m0) + fabs(m1));
+        valueError = 64.0 * FLT_EPSILON * (1.0 + scale);
+        tolerance = valueError + slope * timeError;
+
+        derivative = (m0 + t * (2.0 * c2 + t * 3.0 * c3)) / duration;
+        derivativeTolerance = (6.0 * valueError + 2.0 * slope * timeError) / duration + 2.0 * timeError * fabs(derivative);
+        return a + t * (m0 + t * (c2 + t * c3));
+    }
+
+    // Same for the derivative, where the steepest slope is 6 (and durations are rounded to floats too)
+    derivative = referenceWeightDerivative(mode, t) * (b - a) / duration;
+    derivativeTolerance = (6.0 * valueError + 6.0 * fabs(b - a) * timeError) / duration + 2.0 * timeError * fabs(derivative);
+
+    return a + referenceWeight(mode, t) * (b - a);
+}
+
+// Expected value of a track, and the error a float evaluation may have at that point
+static double referenceValue(const ReferenceTrack& track, double time, double& tolerance, double& derivative, double& derivativeTolerance) {
+    return referenceSegment(track, referenceKey(track, time), time, tolerance, derivative, derivativeTolerance);
+}
+
+// Compile the reference keys into the arena of a timeline
+// With tickSamples set, keys are snapped to the tick grid, and so are the reference timestamps (exactly, in double precision)
+static void compileTimeline(Timeline& timeline) {
+    unsigned int total = 0;
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        timeline.compiled.first[k] = total;
+        total += (unsigned int)timeline.tracks[k].stamps.size();
+    }
+    timeline.compiled.first[TRACK_COUNT] = total;
+
+    timeline.start.resize(total);
+    timeline.invDuration.resize(total);
+    timeline.segments.resize(total);
+    timeline.compiled.start = timeline.start.data();
+    timeline.compiled.invDuration = timeline.invDuration.data();
+    timeline.compiled.segments = timeline.segments.data();
+    if (timeline.compiled.tickSamples) {
+        timeline.startSample.resize(total);
+        timeline.compiled.startSample = timeline.startSample.data();
+    }
+
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        ReferenceTrack& track = timeline.tracks[k];
+        std::vector<float> stamps(track.stamps.begin(), track.stamps.end());
+        std::vector<float> values;
+        for (size_t i = 0; i < track.values.size(); i++)
+            values.push_back(packValue(track.values[i], track.modes[i]));
+
+        compileTrack(timeline.compiled, timeline.compiled.first[k], stamps.data(), values.data(), 1, (unsigned int)stamps.size());
+
+        if (timeline.compiled.startSample)
+            for (size_t i = 0; i < track.stamps.size(); i++)
+                track.stamps[i] = timeline.startSample[timeline.compiled.first[k] + i] * (double)timeline.compiled.samplePeriod;
+    }
+}
+
+// Reference keys of a keyframe file, following the same rules as the loader
+static bool loadReference(Timeline& timeline, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    json j;
+    file >> j;
+
+    for (const auto& frame : j["keyframes"]) {
+        double time = frame["time"];
+        for (const auto& node : frame["nodes"]) {
+            std::string name = node["track"];
+            int k = findTrack(name.data(), name.size());
+            if (k == TRACK_COUNT || k == TRACK_TIMESTAMPS)
+                continue;
+
+            // A repeated timestamp overrides the previous key
+            ReferenceTrack& track = timeline.tracks[k];
+            if (!track.stamps.empty() && (float)track.stamps.back() == (float)time) {
+                track.values.back() = node["value"];
+                track.modes.back() = node["mode"];
+            }
+            else {
+                track.stamps.push_back((float)time); // Timestamps are floats in the engine
+                track.values.push_back(node["value"]);
+                track.modes.push_back(node["mode"]);
+            }
+            timeline.duration = std::max(timeline.duration, time);
+        }
+    }
+
+    // Tracks without keys hold zero
+    for (ReferenceTrack& track : timeline.tracks) {
+        if (track.stamps.empty()) {
+            track.stamps.push_back(0.0);
+            track.values.push_back(0.0);
+            track.modes.push_back(STEP);
+        }
+    }
+    return true;
+}
+
+// Random timeline, every track with its own key count and spacing, using every mode (and some unknown ones)
+static void generateTimeline(Timeline& timeline, unsigned int keysPerTrack, std::mt19937& random) {
+    std::uniform_real_distribution<double> value(-10.0, 10.0);
+    std::uniform_real_distribution<double> spacing(0.001, 0.05);
+    std::uniform_int_distribution<int> mode(0, 15);
+
+    timeline.name = "synthetic_" + std::to_string(keysPerTrack);
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        ReferenceTrack& track = timeline.tracks[k];
+        unsigned int count = keysPerTrack / (1 + k % 4); // Sparse and dense tracks
+        double time = 0.0;
+        for (unsigned int i = 0; i < count; i++) {
+            track.stamps.push_back((float)time);
+            track.values.push_back(value(random));
+            track.modes.push_back(mode(random) % 8 == 7 ? mode(random) : mode(random) % 8);
+            time += spacing(random);
+        }
+        timeline.duration = std::max(timeline.duration, track.stamps.back());
+    }
+}
+
+// Sorted timestamps of 4 sub-frames per frame at 60 fps, from a little before the start to a little after the end
+static std::vector<float> subFrameTimes(const Timeline& timeline) {
+    std::vector<float> times;
+    for (double time = -0.5; time < timeline.duration + 0.5; time += 1.0 / 240.0)
+        times.push_back((float)time);
+    return times;
+}
+
+// Result of checking a timeline against its reference
+struct CheckResult {
+    unsigned long long evaluations = 0;
+    unsigned long long failures = 0;
+    double maxError = 0.0;
+    double maxDerivativeError = 0.0; // Relative
+    double maxIntegralError = 0.0;   // Relative to the integral of the magnitude
+    unsigned int integralModes = 0;  // Interpolation modes of the segments integrals were checked in, one bit each
+};
+
+static void checkValue(CheckResult& result, const Timeline& timeline, int track, double time, float value, const char* path) {
+    double tolerance, derivative, derivativeTolerance;
+    double expected = referenceValue(timeline.tracks[track], time, tolerance, derivative, derivativeTolerance);
+    double error = fabs(value - expected);
+
+    result.evaluations++;
+    result.maxError = std::max(result.maxError, error);
+    if (!(error <= tolerance)) {
+        if (result.failures++ < 10)
+            fprintf(stderr, "%s: %s track %d at %.9g: %.9g, expected %.9g\n", timeline.name.c_str(), path, track, time, value, expected);
+    }
+}
+
+// Check a value and its derivative
+static void checkValue(CheckResult& result, const Timeline& timeline, int track, double time, float value, float derivative, const char* path) {
+    checkValue(result, timeline, track, time, value, path);
+
+    double tolerance, expected, derivativeTolerance;
+    referenceValue(timeline.tracks[track], time, tolerance, expected, derivativeTolerance);
+    double error = fabs(derivative - expected);
+
+    result.evaluations++;
+    result.maxDerivativeError = std::max(result.maxDerivativeError, error / (1.0 + fabs(expected)));
+    if (!(error <= derivativeTolerance)) {
+        if (result.failures++ < 10)
+            fprintf(stderr, "%s: %s derivative track %d at %.9g: %.9g, expected %.9g\n", timeline.name.c_str(), path, track, time, derivative, expected);
+    }
+}
+
+// Check a key index, and a normalized time inside its segment
+static void checkSegment(CheckResult& result, const Timeline& timeline, int track, unsigned int sample, unsigned int key, float t, const char* path) {
+    const ReferenceTrack& reference = timeline.tracks[track];
+    const std::vector<double>& stamps = reference.stamps;
+    double time = sample * (double)timeline.compiled.samplePeriod;
+    size_t i = referenceKey(reference, time);
+
+    result.evaluations++;
+    if (key != timeline.compiled.first[track] + i) {
+        if (result.failures++ < 10)
+            fprintf(stderr, "%s: %s track %d at sample %u: key %u, expected %zu\n", timeline.name.c_str(), path, track, sample, key - timeline.compiled.first[track], i);
+        return;
+    }
+
+    // Held keys (the last one, duplicates, and the first one before it starts) stay at t = 0
+    double expected = 0.0, tolerance = 0.0;
+    if (i + 1 < stamps.size() && stamps[i + 1] > stamps[i] && time > stamps[i]) {
+        double duration = stamps[i + 1] - stamps[i];
+        expected = (time - stamps[i]) / duration;
+        tolerance = 4.0 * FLT_EPSILON + 8.0 * FLT_EPSILON * (fabs(stamps[i]) + fabs(stamps[i + 1]) + duration) / duration * expected;
+    }
+
+    result.evaluations++;
+    if (!(fabs(t - expected) <= tolerance)) {
+        if (result.failures++ < 10)
+            fprintf(stderr, "%s: %s t track %d at sample %u: %.9g, expected %.9g\n", timeline.name.c_str(), path, track, sample, t, expected);
+    }
+}
+
+// Check the integer timeline against the reference: on the tick grid at every key (and a tick before and after it,
+// inside and past the end of its segment), just before every key, far past the end, while playing forward and while seeking
+static void checkSamples(CheckResult& result, const Timeline& timeline, std::mt19937& random) {
+    const KeyframeTimeline<TRACK_COUNT>& compiled = timeline.compiled;
+    const unsigned int tick = compiled.tickSamples;
+
+    unsigned int end = 0;
+    for (int k = 0; k < TRACK_COUNT; k++)
+        end = std::max(end, compiled.startSample[compiled.first[k + 1] - 1]);
+
+    // Stateless lookups
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        for (unsigned int key = compiled.first[k]; key < compiled.first[k + 1]; key++) {
+            unsigned int start = compiled.startSample[key];
+            unsigned int samples[] = { start, start + tick, start > tick ? start - tick : 0, start ? start - 1 : 0, start + tick / 2, end + 100 * tick };
+            for (unsigned int sample : samples) {
+                unsigned int i = findSampleKey(compiled, k, sample);
+                checkSegment(result, timeline, k, sample, i, segmentSampleTime(compiled, i, sample), "findSampleKey");
+                checkValue(result, timeline, k, sample * (double)compiled.samplePeriod, findSampleValue(sample, compiled, k), "findSampleValue");
+            }
+        }
+    }
+
+    // Cursor, playing forward at 60 fps (not on the tick grid), and seeking on and off it
+    KeyframeCursor<TRACK_COUNT> cursor = {};
+    const unsigned int frame = (unsigned int)(1.0 / (60.0 * compiled.samplePeriod)) + 1;
+    std::uniform_int_distribution<unsigned int> seek(0, end + 60 * frame);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (unsigned int step = 0; step * frame < end + 60 * frame; step++) {
+            unsigned int sample = pass ? seek(random) : step * frame;
+            if (pass && step % 2)
+                sample -= sample % tick;
+            updateCursorSample(cursor, sample, compiled);
+            for (int k = 0; k < TRACK_COUNT; k++) {
+                float derivative;
+                double time = sample * (double)compiled.samplePeriod;
+                checkSegment(result, timeline, k, sample, cursor.index[k], cursor.t[k], pass ? "updateCursorSample (seek)" : "updateCursorSample");
+                float value = findValue(cursor, compiled, k, derivative);
+                checkValue(result, timeline, k, time, value, derivative, pass ? "updateCursorSample (seek)" : "updateCursorSample");
+            }
+        }
+    }
+}
+
+// Integral of a track from time 0 up to the start of every key, by Simpson's rule over every segment (exact for the
+// cubic segments of every mode), along with the integral of its magnitude, the scale of the error a float evaluation may have
+struct ReferenceIntegral {
+    std::vector<double> prefix;
+    std::vector<double> magnitude;
+};
+
+// Integral of the segment starting at key i, from its start to time, and of its magnitude
+static double referenceSegmentIntegral(const ReferenceTrack& track, size_t i, double time, double& magnitude) {
+    double from = track.stamps[i];
+    double integral = 0.0;
+    magnitude = 0.0;
+    for (int s = 0; s <= 4; s++) {
+        double tolerance, derivative, derivativeTolerance;
+        double value = referenceSegment(track, i, from + (time - from) * s / 4.0, tolerance, derivative, derivativeTolerance);
+        double weight = (s == 0 || s == 4 ? 1.0 : s % 2 ? 4.0 : 2.0) * (time - from) / 12.0;
+        integral += weight * value;
+        magnitude += weight * fabs(value);
+    }
+    return integral;
+}
+
+static ReferenceIntegral integrateReference(const ReferenceTrack& track) {
+    ReferenceIntegral integral;
+    const std::vector<double>& stamps = track.stamps;
+
+    // The first value is held from time 0
+    integral.prefix.push_back(track.values[0] * stamps[0]);
+    integral.magnitude.push_back(fabs(integral.prefix[0]));
+    for (size_t i = 0; i + 1 < stamps.size(); i++) {
+        double magnitude = 0.0, segment = 0.0, duration = stamps[i + 1] - stamps[i];
+        if (duration > 0.0)
+            segment = referenceSegmentIntegral(track, i, stamps[i + 1], magnitude);
+
+        // Segment lengths are rounded like the float timestamps they're taken from
+        integral.prefix.push_back(integral.prefix[i] + segment);
+        integral.magnitude.push_back(integral.magnitude[i] + (duration > 0.0 ? magnitude * (1.0 + (fabs(stamps[i]) + fabs(stamps[i + 1])) / duration) : 0.0));
+    }
+    return integral;
+}
+
+static void checkIntegral(CheckResult& result, const Timeline& timeline, const ReferenceIntegral& reference, int track, double time, float integral, const char* path) {
+    const ReferenceTrack& keys = timeline.tracks[track];
+    size_t i = referenceKey(keys, time);
+
+    // Held before the first key and after the last one, otherwise inside the segment
+    double expected, magnitude;
+    if (time < keys.stamps[i] || i + 1 == keys.stamps.size()) {
+        expected = reference.prefix[i] + (time - keys.stamps[i]) * keys.values[i];
+        magnitude = fabs(time - keys.stamps[i]) * fabs(keys.values[i]);
+    }
+    else {
+        expected = reference.prefix[i] + referenceSegmentIntegral(keys, i, time, magnitude);
+        result.integralModes |= 1u << std::min(keys.modes[i + 1], SPLINE + 1);
+    }
+
+    // Float rounding of every segment summed up, and of the offset into the segment
+    double tolerance, derivative, derivativeTolerance;
+    double value = referenceSegment(keys, i, time, tolerance, derivative, derivativeTolerance);
+    double scale = reference.magnitude[i] + magnitude;
+    tolerance = 64.0 * FLT_EPSILON * scale + 8.0 * FLT_EPSILON * (fabs(time) + fabs(keys.stamps[i])) * (fabs(value) + tolerance) + FLT_MIN;
+
+    double error = fabs(integral - expected);
+    result.evaluations++;
+    result.maxIntegralError = std::max(result.maxIntegralError, error / (1.0 + scale));
+    if (!(error <= tolerance)) {
+        if (result.failures++ < 10)
+            fprintf(stderr, "%s: %s track %d at %.9g: %.9g, expected %.9g\n", timeline.name.c_str(), path, track, time, integral, expected);
+    }
+}
+
+// Check integrals of every track against the reference: before the start, at, just before and inside every key's
+// segment, past the end, and at random positions (by sample on integer timelines, also from the cursor after seeking)
+static void checkIntegrals(CheckResult& result, const Timeline& timeline, std::mt19937& random) {
+    const KeyframeTimeline<TRACK_COUNT>& compiled = timeline.compiled;
+    std::vector<KeyframeIntegral> integral;
+    std::uniform_real_distribution<double> seek(0.0, timeline.duration + 1.0);
+
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        const ReferenceTrack& track = timeline.tracks[k];
+        ReferenceIntegral reference = integrateReference(track);
+        integral.resize(compiled.first[k + 1] - compiled.first[k]);
+        integrateTrack(compiled, k, integral.data());
+
+        if (compiled.startSample) {
+            const double rate = 1.0 / compiled.samplePeriod;
+            auto check = [&](unsigned int sample) {
+                checkIntegral(result, timeline, reference, k, sample * (double)compiled.samplePeriod, findSampleIntegral(sample, compiled, k, integral.data()), "findSampleIntegral");
+            };
+            for (unsigned int key = compiled.first[k]; key < compiled.first[k + 1]; key++) {
+                unsigned int start = compiled.startSample[key];
+                unsigned int next = key + 1 < compiled.first[k + 1] ? compiled.startSample[key + 1] : start + 60 * compiled.tickSamples;
+                check(start);
+                check(start ? start - 1 : 0);
+                check(start + (next - start) / 4);
+                check(start + (next - start) / 2);
+            }
+            check((unsigned int)((timeline.duration + 10.0) * rate));
+
+            // After seeking, from the cursor
+            KeyframeCursor<TRACK_COUNT> cursor = {};
+            for (int s = 0; s < 256; s++) {
+                unsigned int sample = (unsigned int)(seek(random) * rate);
+                updateCursorSample(cursor, sample, compiled);
+                checkIntegral(result, timeline, reference, k, sample * (double)compiled.samplePeriod,
+                    findSampleIntegral(cursor, sample, compiled, k, integral.data()), "findSampleIntegral (cursor, seek)");
+                check(sample);
+            }
+        }
+        else {
+            auto check = [&](float time) {
+                checkIntegral(result, timeline, reference, k, time, findIntegral(time, compiled, k, integral.data()), "findIntegral");
+            };
+            for (size_t i = 0; i < track.stamps.size(); i++) {
+                float stamp = (float)track.stamps[i];
+                double duration = i + 1 < track.stamps.size() ? track.stamps[i + 1] - stamp : 1.0;
+                check(stamp);
+                check(nextafterf(stamp, -INFINITY));
+                check(stamp + 0.25f * (float)duration);
+                check(stamp + 0.5f * (float)duration);
+            }
+            check(-0.5f);
+            check((float)(timeline.duration + 10.0));
+
+            // After seeking
+            for (int s = 0; s < 256; s++)
+                check((float)seek(random));
+        }
+    }
+}
+
+// Check every evaluation path against the reference: at, just before and between every key,
+// while playing forward, and while seeking at random
+static CheckResult checkTimeline(const Timeline& timeline, std::mt19937& random) {
+    CheckResult result;
+    const KeyframeTimeline<TRACK_COUNT>& compiled = timeline.compiled;
+
+    // Stateless lookups and the packed format decoder
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        const ReferenceTrack& track = timeline.tracks[k];
+        for (size_t i = 0; i < track.stamps.size(); i++) {
+            float stamp = (float)track.stamps[i];
+            float times[] = { stamp, nextafterf(stamp, -INFINITY), stamp + 0.25f * (float)(i + 1 < track.stamps.size() ? track.stamps[i + 1] - stamp : 1.0) };
+            for (float time : times) {
+                float derivative;
+                checkValue(result, timeline, k, time, findValue(time, compiled, k), "findValue");
+                float value = findValue(time, compiled, k, derivative);
+                checkValue(result, timeline, k, time, value, derivative, "findValue (derivative)");
+            }
+
+            if (i + 1 < track.stamps.size() && track.stamps[i + 1] > track.stamps[i]) {
+                float t = 0.5f;
+                float time = (float)(track.stamps[i] + 0.5 * (track.stamps[i + 1] - track.stamps[i]));
+                float a = packValue(track.values[i], track.modes[i]);
+                float b = packValue(track.values[i + 1], track.modes[i + 1]);
+                if ((float)track.stamps[i] + t * (float)(track.stamps[i + 1] - track.stamps[i]) == time && track.modes[i + 1] != SPLINE)
+                    checkValue(result, timeline, k, time, interpolate(a, b, t), "interpolate");
+            }
+        }
+    }
+
+    // Cursor and pose, playing forward at 60 fps, and seeking
+    KeyframeCursor<TRACK_COUNT> cursor = {};
+    alignas(16) float pose[POSE_STRIDE];
+    alignas(16) float velocity[POSE_STRIDE];
+    std::uniform_real_distribution<double> seek(-1.0, timeline.duration + 1.0);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (double frame = 0.0; frame < timeline.duration + 0.1; frame += 1.0 / 60.0) {
+            float time = (float)(pass ? seek(random) : frame);
+            updateCursor(cursor, time, compiled);
+            evaluatePose(cursor, compiled, pose);
+            for (int k = 0; k < TRACK_COUNT; k++) {
+                float derivative;
+                checkValue(result, timeline, k, time, pose[k], pass ? "evaluatePose (seek)" : "evaluatePose");
+                checkValue(result, timeline, k, time, findValue(cursor, compiled, k), "findValue (cursor)");
+                float value = findValue(cursor, compiled, k, derivative);
+                checkValue(result, timeline, k, time, value, derivative, "findValue (cursor, derivative)");
+            }
+
+            evaluatePose(cursor, compiled, pose, velocity);
+            for (int k = 0; k < TRACK_COUNT; k++)
+                checkValue(result, timeline, k, time, pose[k], velocity[k], "evaluatePose (velocity)");
+        }
+    }
+
+    // Many sorted timestamps at once: 4 sub-frames per frame at 60 fps, every track
+    std::vector<float> times = subFrameTimes(timeline);
+    std::vector<unsigned int> tracks(TRACK_COUNT);
+    for (int k = 0; k < TRACK_COUNT; k++)
+        tracks[k] = k;
+
+    std::vector<float> samples(times.size() * TRACK_COUNT);
+    evaluateSamples(compiled, times.data(), (unsigned int)times.size(), tracks.data(), TRACK_COUNT, samples.data());
+    for (size_t s = 0; s < times.size(); s++)
+        for (int k = 0; k < TRACK_COUNT; k++)
+            checkValue(result, timeline, k, times[s], samples[s * TRACK_COUNT + k], "evaluateSamples");
+
+    // Integrals, and the same keys on the integer timeline
+    checkIntegrals(result, timeline, random);
+
+    Timeline snapped;
+    snapped.name = timeline.name + " (samples)";
+    snapped.duration = timeline.duration;
+    for (int k = 0; k < TRACK_COUNT; k++)
+        snapped.tracks[k] = timeline.tracks[k];
+    snapped.compiled.tickSamples = keyTick;
+    snapped.compiled.samplePeriod = samplePeriod;
+    compileTimeline(snapped);
+    checkSamples(result, snapped, random);
+    checkIntegrals(result, snapped, random);
+
+    return result;
+}
+
+// Timing of the evaluation paths, in nanoseconds
+struct BenchResult {
+    double findValue = 0.0;      // Stateless findValue(), random time and track
+    double cursorFindValue = 0.0; // findValue() from the cursor, per track
+    double updateCursor = 0.0;   // Cursor update of every track, per frame of playback
+    double pose = 0.0;           // Cursor update and full pose, per frame of playback
+    double poseVelocity = 0.0;   // Cursor update, full pose and its velocity, per frame of playback
+    double poseSeek = 0.0;       // Cursor update and full pose, seeking at random every frame
+    double sample = 0.0;         // evaluateSamples() of every track at sorted sub-frames, per value
+    double sampleFindValue = 0.0; // Stateless findValue() of every track at the same sub-frames, per value
+};
+
+// Keeps results alive, so the compiler can't remove the measured work
+static volatile float sink;
+
+template<typename Function>
+static double measure(size_t calls, Function function) {
+    auto begin = std::chrono::steady_clock::now();
+    float sum = 0.0f;
+    for (size_t i = 0; i < calls; i++)
+        sum += function(i);
+    auto end = std::chrono::steady_clock::now();
+    sink = sum;
+    return std::chrono::duration<double, std::nano>(end - begin).count() / calls;
+}
+
+static BenchResult benchTimeline(const Timeline& timeline, std::mt19937& random) {
+    BenchResult result;
+    const KeyframeTimeline<TRACK_COUNT>& compiled = timeline.compiled;
+    const size_t calls = 1 << 20;
+    const size_t frames = 1 << 16;
+
+    // Random times and tracks, prepared up front
+    std::uniform_real_distribution<float> time(0.0f, (float)timeline.duration);
+    std::vector<float> times(calls);
+    for (float& t : times)
+        t = time(random);
+
+    // Playback at 60 fps, wrapping around at the end
+    auto frameTime = [&](size_t i) {
+        return (float)fmod(i / 60.0, timeline.duration + 1.0);
+    };
+
+    KeyframeCursor<TRACK_COUNT> cursor = {};
+    alignas(16) float pose[POSE_STRIDE];
+
+    result.findValue = measure(calls, [&](size_t i) {
+        return findValue(times[i], compiled, (unsigned int)(i % TRACK_COUNT));
+    });
+
+    result.updateCursor = measure(frames, [&](size_t i) {
+        updateCursor(cursor, frameTime(i), compiled);
+        return cursor.t[i % TRACK_COUNT];
+    });
+
+    result.cursorFindValue = measure(calls, [&](size_t i) {
+        return findValue(cursor, compiled, (unsigned int)(i % TRACK_COUNT));
+    });
+
+    result.pose = measure(frames, [&](size_t i) {
+        updateCursor(cursor, frameTime(i), compiled);
+        evaluatePose(cursor, compiled, pose);
+        return pose[i % TRACK_COUNT];
+    });
+
+    alignas(16) float velocity[POSE_STRIDE];
+    result.poseVelocity = measure(frames, [&](size_t i) {
+        updateCursor(cursor, frameTime(i), compiled);
+        evaluatePose(cursor, compiled, pose, velocity);
+        return velocity[i % TRACK_COUNT];
+    });
+
+    result.poseSeek = measure(frames, [&](size_t i) {
+        updateCursor(cursor, times[i], compiled);
+        evaluatePose(cursor, compiled, pose);
+        return pose[i % TRACK_COUNT];
+    });
+
+    // Sub-frames, all at once and one by one
+    std::vector<float> subFrames = subFrameTimes(timeline);
+    std::vector<unsigned int> tracks(TRACK_COUNT);
+    for (int k = 0; k < TRACK_COUNT; k++)
+        tracks[k] = k;
+
+    std::vector<float> samples(subFrames.size() * TRACK_COUNT);
+    result.sample = measure(1, [&](size_t) {
+        evaluateSamples(compiled, subFrames.data(), (unsigned int)subFrames.size(), tracks.data(), TRACK_COUNT, samples.data());
+        return samples[0];
+    }) / samples.size();
+
+    result.sampleFindValue = measure(samples.size(), [&](size_t i) {
+        return findValue(subFrames[i / TRACK_COUNT], compiled, (unsigned int)(i % TRACK_COUNT));
+    });
+
+    return result;
+}
+
+int main(int argc, char** argv) {
+    const std::string keyframesPath = argc > 1 ? argv[1] : "../../assets/keyframes/keyframes.json";
+    const char* resultsPath = argc > 2 ? argv[2] : "keyframe_bench.json";
+
+    std::mt19937 random(8);
+    std::vector<Timeline> timelines(4);
+
+    // Keyframe file, compiled by the actual loader
+    Timeline& shipped = timelines[0];
+    shipped.name = "keyframes.json";
+    if (!loadReference(shipped, keyframesPath)) {
+        fprintf(stderr, "Could not open file: %s\n", keyframesPath.c_str());
+        return 1;
+    }
+    loadKeyframesFromJSON(keyframesPath);
+    shipped.compiled = keyframes;
+
+#ifdef KEY_TICK
+    // The loader snaps keys to the tick grid, so the reference has to use the same timestamps
+    for (int k = 0; k < TRACK_COUNT; k++)
+        for (size_t i = 0; i < shipped.tracks[k].stamps.size(); i++)
+            shipped.tracks[k].stamps[i] = keyframes.start[keyframes.first[k] + i];
+#endif
+
+    // Synthetic timelines
+    generateTimeline(timelines[1], 1000, random);
+    generateTimeline(timelines[2], 10000, random);
+    generateTimeline(timelines[3], 100000, random);
+    for (size_t i = 1; i < timelines.size(); i++)
+        compileTimeline(timelines[i]);
+
+    FILE* out = fopen(resultsPath, "w");
+    if (!out) {
+        fprintf(stderr, "Could not open file: %s\n", resultsPath);
+        return 1;
+    }
+
+    bool passed = true;
+    unsigned int integralModes = 0;
+#ifdef KEYFRAME_SIMD
+    fprintf(out, "{\n    \"simd\": true,\n    \"timelines\": [\n");
+#else
+    fprintf(out, "{\n    \"simd\": false,\n    \"timelines\": [\n");
+#endif
+
+    for (size_t i = 0; i < timelines.size(); i++) {
+        const Timeline& timeline = timelines[i];
+        CheckResult check = checkTimeline(timeline, random);
+        BenchResult bench = benchTimeline(timeline, random);
+        passed &= check.failures == 0;
+        integralModes |= check.integralModes;
+
+        printf("%-18s %8u keys  findValue %6.1f ns  pose %7.1f ns  seek %7.1f ns  sample %5.1f ns  checks %llu (%llu failed)\n",
+            timeline.name.c_str(), timeline.compiled.first[TRACK_COUNT], bench.findValue, bench.pose, bench.poseSeek, bench.sample,
+            check.evaluations, check.failures);
+
+        fprintf(out,
+            "        {\n"
+            "            \"name\": \"%s\",\n"
+            "            \"keys\": %u,\n"
+            "            \"duration\": %.9g,\n"
+            "            \"ns_per_find_value\": %.3f,\n"
+            "            \"ns_per_cursor_find_value\": %.3f,\n"
+            "            \"ns_per_update_cursor\": %.3f,\n"
+            "            \"ns_per_pose\": %.3f,\n"
+            "            \"ns_per_pose_velocity\": %.3f,\n"
+            "            \"ns_per_pose_seek\": %.3f,\n"
+            "            \"ns_per_sample\": %.3f,\n"
+            "            \"ns_per_sample_find_value\": %.3f,\n"
+            "            \"checks\": %llu,\n"
+            "            \"failures\": %llu,\n"
+            "            \"max_error\": %.9g,\n"
+            "            \"max_derivative_error\": %.9g,\n"
+            "            \"max_integral_error\": %.9g\n"
+            "        }%s\n",
+            timeline.name.c_str(), timeline.compiled.first[TRACK_COUNT], timeline.duration,
+            bench.findValue, bench.cursorFindValue, bench.updateCursor, bench.pose, bench.poseVelocity, bench.poseSeek,
+            bench.sample, bench.sampleFindValue,
+            check.evaluations, check.failures, check.maxError, check.maxDerivativeError, check.maxIntegralError,
+            i + 1 < timelines.size() ? "," : "");
+    }
+
+    // Integrals have to be checked inside segments of every mode, and of an unknown one
+    if (integralModes != (2u << (SPLINE + 1)) - 1) {
+        fprintf(stderr, "Integrals weren't checked in every interpolation mode: %x\n", integralModes);
+        passed = false;
+    }
+
+    fprintf(out, "    ],\n    \"passed\": %s\n}\n", passed ? "true" : "false");
+    fclose(out);
+
+    return passed ? 0 : 1;
+}
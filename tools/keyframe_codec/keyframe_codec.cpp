@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+// Keyframe codec
+//
+// Builds on Linux (or any platform with a C++20 compiler), without Win32:
+//   g++ -std=c++20 -O2 -DDEBUG -o keyframe_codec keyframe_codec.cpp
+//
+// Usage:
+//   keyframe_codec input.json output.h [value bits] [time step]
+//
+// Encodes a keyframe file into the compact binary format of keyframe_codec.h (12 bits per value and
+// 1/1024 s time steps by default), and writes it as a release header (ENCODED_KEYFRAMES).
+// Reports the encoded size and the error it adds, and benchmarks decoding for the keyframe file,
+// and for a timeline 100 times its length.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../src/keyframes.h"
+#include "../../src/keyframe_loader.h"
+#include "../../src/keyframe_codec.h"
+
+// Keys of every track, and the timeline they are decoded into
+struct DecodedTimeline {
+    std::vector<float> start, invDuration, values;
+    std::vector<KeyframeSegment> segments;
+    KeyframeTimeline<TRACK_COUNT> timeline = {};
+
+    explicit DecodedTimeline(size_t keys) : start(keys), invDuration(keys), values(keys), segments(keys) {
+        timeline.start = start.data();
+        timeline.invDuration = invDuration.data();
+        timeline.segments = segments.data();
+    }
+};
+
+// Keys of every track, repeated one after the other
+static void repeatTracks(std::vector<float> (&stamps)[TRACK_COUNT], std::vector<float> (&values)[TRACK_COUNT], unsigned int times, float length) {
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        std::vector<float> repeatedStamps, repeatedValues;
+        for (unsigned int r = 0; r < times; r++) {
+            for (size_t i = 0; i < liveTables->trackStamps[k].size(); i++) {
+                repeatedStamps.push_back(liveTables->trackStamps[k][i] + r * length);
+                repeatedValues.push_back(liveTables->trackValues[k][i]);
+            }
+        }
+        stamps[k].swap(repeatedStamps);
+        values[k].swap(repeatedValues);
+    }
+}
+
+// Nanoseconds per decode (including compiling the segments)
+static double decodeTime(const std::vector<unsigned char>& encoded, size_t keys) {
+    DecodedTimeline decoded(keys);
+    const int repeats = keys > 10000 ? 10 : 1000;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++)
+        decodeKeyframes(decoded.timeline, encoded.data(), decoded.values.data());
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - begin).count() / repeats;
+}
+
+// Encoded data as a release header, 16 bytes per line
+static size_t writeHeader(const std::string& filename, const std::vector<unsigned char>& encoded, size_t keys, unsigned int bits, float timeStep) {
+    std::string text;
+    char line[256];
+
+    snprintf(line, sizeof(line), "// Generated by Keyframe Codec (https://github.com/adamkohazi/demo-sk8), %u bits per value, time step %g s\n", bits, timeStep);
+    text += line;
+    text += "#ifndef KEYFRAME_DATA_H_\n#define KEYFRAME_DATA_H_\n\n";
+    text += "// Keys of every track in the compact binary format of keyframe_codec.h, in the order of the Track enum\n";
+    text += "#define ENCODED_KEYFRAMES\n";
+    text += "#define ENCODED_KEY_COUNT " + std::to_string(keys) + "\n\n";
+
+    text += "constexpr unsigned char keyframeCodec[] = {";
+    for (size_t i = 0; i < encoded.size(); i++) {
+        snprintf(line, sizeof(line), "%s0x%02x,", i % 16 ? " " : "\n\t", encoded[i]);
+        text += line;
+    }
+    text += "\n};\n\n#endif //KEYFRAME_DATA_H_";
+
+    std::ofstream file(filename);
+    file << text;
+    return text.size();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: keyframe_codec input.json output.h [value bits] [time step]\n");
+        return 1;
+    }
+    const unsigned int bits = argc > 3 ? (unsigned int)atoi(argv[3]) : 12;
+    const float timeStep = argc > 4 ? (float)atof(argv[4]) : 1.f / 1024.f;
+
+    std::ifstream input(argv[1], std::ios::binary | std::ios::ate);
+    if (!input.is_open()) {
+        fprintf(stderr, "Could not open file: %s\n", argv[1]);
+        return 1;
+    }
+    size_t jsonSize = (size_t)input.tellg();
+    loadKeyframesFromJSON(argv[1]);
+
+    unsigned int trackBits[TRACK_COUNT];
+    for (unsigned int& b : trackBits)
+        b = bits;
+
+    // Keyframe file
+    size_t keys = keyframes.first[TRACK_COUNT];
+    std::vector<unsigned char> encoded = encodeKeyframes(liveTables->trackStamps, liveTables->trackValues, trackBits, timeStep);
+    if (encoded.empty()) {
+        fprintf(stderr, "A track has more than 65535 keys\n");
+        return 1;
+    }
+    size_t headerSize = writeHeader(argv[2], encoded, keys, bits, timeStep);
+
+    // Error added by encoding, at 4 sub-frames per frame at 60 fps
+    DecodedTimeline decoded(keys);
+    decodeKeyframes(decoded.timeline, encoded.data(), decoded.values.data());
+
+    float length = 0.f;
+    for (int k = 0; k < TRACK_COUNT; k++)
+        length = std::max(length, liveTables->trackStamps[k].back());
+
+    double maxError = 0.0;
+    for (double time = 0.0; time < length + 1.0; time += 1.0 / 240.0)
+        for (int k = 0; k < TRACK_COUNT; k++)
+            maxError = std::max(maxError, (double)fabsf(findValue((float)time, decoded.timeline, k) - findValue((float)time, keyframes, k)));
+
+    // 100 times longer
+    std::vector<float> longStamps[TRACK_COUNT], longValues[TRACK_COUNT];
+    repeatTracks(longStamps, longValues, 100, length + 1.f);
+    std::vector<unsigned char> longEncoded = encodeKeyframes(longStamps, longValues, trackBits, timeStep);
+    if (longEncoded.empty()) {
+        fprintf(stderr, "A track has more than 65535 keys 100 times longer\n");
+        return 1;
+    }
+
+    size_t rawSize = sizeof(unsigned short) * TRACK_COUNT + 2 * sizeof(float) * keys;
+    printf("Keys: %zu\n", keys);
+    printf("Size: %zu bytes encoded (%zu bytes as floats, %zu bytes of .json), %zu bytes of header text\n", encoded.size(), rawSize, jsonSize, headerSize);
+    printf("Max error: %g\n", maxError);
+    double decode = decodeTime(encoded, keys);
+    double longDecode = decodeTime(longEncoded, keys * 100);
+    printf("Decode: %.1f us (%.1f ns per key)\n", decode / 1000.0, decode / keys);
+    printf("100x: %zu keys, %zu bytes encoded, decode %.1f us (%.1f ns per key)\n", keys * 100, longEncoded.size(), longDecode / 1000.0, longDecode / (keys * 100));
+
+    return 0;
+}
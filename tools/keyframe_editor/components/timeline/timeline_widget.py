@@ -66,6 +66,9 @@ class TimelineEditor(BoxLayout):
             if keyframe:
                 self.ids.keyframe_editor.keyframe = keyframe
 
+            # Push the changes to a running debug build, if there is one
+            self.timeline.push()
+
             # Autosave
             if self.ids.autosave_checkbox.active:
                 self.export_file(self.ids.file_path_input.text)
@@ -133,7 +136,7 @@ class TimelineEditor(BoxLayout):
         if filepath:
             if not filepath.endswith('.json'):
                 filepath += '.json'
-            self.timeline.export_json(filepath, 64)
+            self.timeline.export_json(filepath)
             print(f"Exported to {filepath}")
         else:
             print("Please enter a valid export path")
\ No newline at end of file
@@ -8,6 +8,9 @@ class Mode(Enum):
     QUADRATIC_IN = 2
     QUADRATIC_OUT = 3
     SMOOTHSTEP = 4
+    CUBIC_IN = 5
+    CUBIC_OUT = 6
+    SPLINE = 7
 
 
 class Node(dataobject):
@@ -0,0 +1,123 @@
+import mmap
+import os
+import socket
+import struct
+import sys
+
+# Pushes edited tracks to a running debug build, without writing the .json file
+# The layout of the ring and of the messages is described in src/keyframe_link.h
+LINK_NAME = "sk8_keyframes"
+LINK_MAGIC = 0x4C384B53
+LINK_VERSION = 2
+SESSION = 12
+HEAD = 64
+TAIL = 128
+DATA = 192
+
+
+class KeyframeLink:
+    def __init__(self):
+        self._ring = None
+
+    def _open(self) -> bool:
+        """Map the demo's ring, if a demo is running (again for every message, the demo may have been restarted)"""
+        try:
+            if sys.platform == "win32":
+                self._ring = mmap.mmap(-1, DATA, tagname="Local\\" + LINK_NAME)
+                magic, version, capacity = struct.unpack_from("<III", self._ring, 0)
+                self._ring.close()
+                self._ring = mmap.mmap(-1, DATA + capacity, tagname="Local\\" + LINK_NAME)
+            else:
+                fd = os.open("/dev/shm/" + LINK_NAME, os.O_RDWR)
+                try:
+                    self._ring = mmap.mmap(fd, 0)
+                finally:
+                    os.close(fd)
+                magic, version, capacity = struct.unpack_from("<III", self._ring, 0)
+        except (OSError, ValueError):
+            self._ring = None
+            return False
+
+        if magic != LINK_MAGIC or version != LINK_VERSION or capacity & (capacity - 1) or len(self._ring) < DATA + capacity:
+            self.close()
+            return False
+        self._capacity = capacity
+        return True
+
+    def session(self):
+        """Id of the running demo (new for every run), None if there is no demo running"""
+        if not self._open():
+            return None
+        try:
+            return struct.unpack_from("<I", self._ring, SESSION)[0]
+        finally:
+            self.close()
+
+    def close(self):
+        if self._ring is not None:
+            self._ring.close()
+            self._ring = None
+
+    def _notify(self) -> bool:
+        """Wake the demo up, false if it isn't running"""
+        try:
+            if sys.platform == "win32":
+                import ctypes
+                kernel32 = ctypes.windll.kernel32
+                event = kernel32.OpenEventW(0x0002, False, "Local\\" + LINK_NAME + "_push") # EVENT_MODIFY_STATE
+                if not event:
+                    return False
+                kernel32.SetEvent(event)
+                kernel32.CloseHandle(event)
+            else:
+                directory = os.environ.get("TMPDIR", "/tmp")
+                with socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM) as notification:
+                    notification.sendto(b"\x01", os.path.join(directory, LINK_NAME + ".sock"))
+            return True
+        except OSError:
+            return False
+
+    @staticmethod
+    def encode(time: float, tracks: dict) -> bytes:
+        """Message with the keys of some tracks: {name: (timestamps, packed values)}"""
+        parts = [b"", struct.pack("<fI", time, len(tracks))]
+        for name, (stamps, values) in tracks.items():
+            encoded = name.encode("utf-8")
+            parts.append(struct.pack("<II", len(stamps), len(encoded)))
+            parts.append(encoded + b"\0" * (-len(encoded) % 4))
+            parts.append(struct.pack(f"<{len(stamps)}f", *stamps))
+            parts.append(struct.pack(f"<{len(values)}I", *values))
+        parts[0] = struct.pack("<I", 4 + sum(len(part) for part in parts))
+        return b"".join(parts)
+
+    def publish(self, message: bytes, session: int) -> bool:
+        """Write a message to the ring of a demo session and wake it up, false if that demo isn't running or its ring is full"""
+        if not self._open():
+            return False
+        try:
+            return self._write(message, session) and self._notify()
+        finally:
+            self.close()
+
+    def _write(self, message: bytes, session: int) -> bool:
+        if struct.unpack_from("<I", self._ring, SESSION)[0] != session:
+            return False
+
+        capacity = self._capacity
+        head, = struct.unpack_from("<I", self._ring, HEAD)
+        tail, = struct.unpack_from("<I", self._ring, TAIL)
+        offset = head % capacity
+        skip = capacity - offset if capacity - offset < len(message) else 0
+        if ((head - tail) % (1 << 32)) + skip + len(message) > capacity:
+            return False
+
+        # Messages aren't split by the end of the ring, a size of 0 skips to its start
+        if skip:
+            struct.pack_into("<I", self._ring, DATA + offset, 0)
+            head += skip
+            offset = 0
+
+        # The head moves once the message is written
+        self._ring[DATA + offset:DATA + offset + len(message)] = message
+        struct.pack_into("<I", self._ring, HEAD, (head + len(message)) % (1 << 32))
+        return True
@@ -3,6 +3,7 @@ import pandas
 import struct
 from kivy.event import EventDispatcher
 from keyframe import Keyframe, Mode
+from keyframe_link import KeyframeLink
 
 class Timeline(EventDispatcher):
     def __init__(self, **kwargs):
@@ -12,6 +13,10 @@ class Timeline(EventDispatcher):
         self._time = 0.0
         self._tracks = []
         self._keyframes = []
+        self._extra = {} # Clips, generators and anything else the editor doesn't edit, saved back unchanged
+        self._link = KeyframeLink()
+        self._pushed = {} # Keys of each track as the running demo has them
+        self._session = None # Run of the demo they were pushed to
     
     def on_change(self, *args):
         """Default handler for the event"""
@@ -92,7 +97,8 @@ class Timeline(EventDispatcher):
             data = {
                 'time': self._time,
                 'tracks': self._tracks,
-                'keyframes': [kf.to_dict() for kf in self.keyframes]
+                'keyframes': [kf.to_dict() for kf in self.keyframes],
+                **self._extra
             }
 
             # Pad or truncate to fixsize
@@ -110,6 +116,37 @@ class Timeline(EventDispatcher):
         except Exception as e:
             raise(f"Failed to export JSON: {e}")
 
+    def push(self) -> bool:
+        """
+        Push the tracks that changed since the last push to a running debug build, over shared memory (no file is written)
+        False if there is no demo running, or it couldn't take the push, then the next push sends the tracks again
+        A restarted demo loads the .json file, which may be older than the editor, so it gets every track
+        """
+        session = self._link.session()
+        if session is None:
+            return False
+        if session != self._session:
+            self._pushed = {}
+            self._session = session
+
+        tracks = {track_name: ([], []) for track_name in self._tracks}
+        for kf in self.keyframes:
+            for node in kf.nodes:
+                if node.track in tracks:
+                    # Packed like the demo reads the .json file: the mode in the last 4 bits
+                    bits = struct.unpack('<I', struct.pack('<f', node.value))[0]
+                    tracks[node.track][0].append(kf.time)
+                    tracks[node.track][1].append((bits & ~0xF) | (0xF & node.mode.value))
+        tracks = {track_name: keys for track_name, keys in tracks.items() if self._pushed.get(track_name) != keys}
+        if not tracks:
+            return True
+
+        if not self._link.publish(KeyframeLink.encode(self._time, tracks), session):
+            self._pushed = {}
+            return False
+        self._pushed.update(tracks)
+        return True
+
     def import_json(self, filename):
         try:
             with open(filename, 'r', encoding='utf-8') as f:
@@ -118,6 +155,7 @@ class Timeline(EventDispatcher):
             self._time = float(data.get('time', 0.0))
             self._tracks = data.get('tracks', [])
             self._keyframes = []
+            self._extra = {key: value for key, value in data.items() if key not in ('time', 'tracks', 'keyframes')}
             
             for kf_data in data.get('keyframes', []):
                 time = float(kf_data['time'])
@@ -170,46 +208,63 @@ class Timeline(EventDispatcher):
             raise Exception(f"Failed to export Excel: {e}")
 
     def export_header(self, filename: str):
+        """
+        Export keyframe data for release builds, as a keyframe table:
+            - timestamps are written as a separate array
+            - every other track is a column of keyframeTable, one row per keyframe
+        Column order follows the track list, and has to match TRACK_LIST in src/tracks.h
+        The shipped keyframe_data.h is written by the keyframe reducer (tools/keyframe_reducer, SPARSE_KEYFRAMES)
+        from the saved .json file, this table is the fallback it is compared with
+        """
         try:
             with open(filename, "w", encoding="utf-8") as f:
                 # Header notice
-                f.write('// Generated by Keyframe Editor (https://github.com/adamkohazi/demo-sk8/)\n\n')
-                f.write('#ifndef KEYFRAME_DATA_H_')
-                f.write('#define KEYFRAME_DATA_H_')
-                # Build arrays per track name
-                for track_name in self.tracks:
+                f.write('// Generated by Keyframe Editor (https://github.com/adamkohazi/demo-sk8)\n')
+                f.write('#ifndef KEYFRAME_DATA_H_\n')
+                f.write('#define KEYFRAME_DATA_H_\n\n')
 
-                    # Collect all node entries for this track across all keyframes
+                # Collect compact values per track name
+                columns = {}
+                for track_name in self.tracks:
                     entries = []
                     for kf in self.keyframes:
                         for node in kf.nodes:
                             if node.track == track_name:
-                                entries.append((kf.time, node.value, node.mode.value))
-
-                    # Start array for this track
-                    f.write(f"const float {track_name}[] = {{\n")
-
-                    # Write rows
-                    for (timestamp, value, mode) in entries:
-                        # Use compact float defs instead
-                        float_bytes = struct.pack('!f', value) # Pack into 4 bytes (float32).
-                        float_int = int.from_bytes(float_bytes, byteorder='big') # Convert to integer
-
-                        if(track_name == "timestamps"):
-                            float_int &= ~0xFFF # Mask out the last 12 bits
-                        else:
-                            float_int &= ~0xFFFF # Mask out the last 16 bits
-                            float_int |= 0xF & int(mode) # Pack interpolation mode into last 4 bits
-
-                        # Convert back to bytes → float
-                        float_bytes = float_int.to_bytes(4, byteorder='big')
-                        value = struct.unpack('!f', float_bytes)[0]
-                            
-                        f.write(f"\t{value}f,\n")
-                    f.write("};\n\n")
+                                entries.append(self._pack_value(track_name, node.value, node.mode.value))
+                    columns[track_name] = entries
+
+                # Timestamps
+                f.write("constexpr float timestamps[] = {\n")
+                for value in columns.get("timestamps", []):
+                    f.write(f"\t{value}f,\n")
+                f.write("};\n\n")
+
+                # Every other track, row by row
+                value_tracks = [t for t in self.tracks if t != "timestamps"]
+                f.write(f"// Columns: {', '.join(value_tracks)}\n")
+                f.write("alignas(16) constexpr float keyframeTable[][POSE_STRIDE] = {\n")
+                for row in zip(*(columns[t] for t in value_tracks)):
+                    f.write("\t{ " + ", ".join(f"{value}f" for value in row) + " },\n")
+                f.write("};\n\n")
                 f.write('#endif //KEYFRAME_DATA_H_')
 
             print(f"Header successfully exported to {filename}")
 
         except Exception as e:
-            raise RuntimeError(f"Failed to export header: {e}")
\ No newline at end of file
+            raise RuntimeError(f"Failed to export header: {e}")
+
+    @staticmethod
+    def _pack_value(track_name: str, value: float, mode: int) -> float:
+        # Use compact float defs instead
+        float_bytes = struct.pack('!f', value) # Pack into 4 bytes (float32).
+        float_int = int.from_bytes(float_bytes, byteorder='big') # Convert to integer
+
+        if(track_name == "timestamps"):
+            float_int &= ~0xFFF # Mask out the last 12 bits
+        else:
+            float_int &= ~0xFFFF # Mask out the last 16 bits
+            float_int |= 0xF & int(mode) # Pack interpolation mode into last 4 bits
+
+        # Convert back to bytes → float
+        float_bytes = float_int.to_bytes(4, byteorder='big')
+        return struct.unpack('!f', float_bytes)[0]
@@ -0,0 +1,240 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+// Keyframe parser and cache benchmark
+//
+// Builds on Linux (or any platform with a C++20 compiler), without Win32:
+//   g++ -std=c++20 -O2 -DDEBUG -o keyframe_parse_bench keyframe_parse_bench.cpp
+//
+// Usage:
+//   keyframe_parse_bench [keyframes.json] [synthetic.json] [synthetic MB]
+//
+// Compares the memory mapped keyframe parser of keyframe_parser.h with reading the file into a JSON document
+// (the loader's previous path), on the given keyframe file and on a synthetic one (50 MB by default, written
+// to synthetic.json by repeating the keyframes). Both have to give the same keys, bit for bit, and the
+// parser must not allocate once the track tables have grown. Also times loading the keyframe file with and
+// without its cache, which has to give the same tables. The exit code is non-zero if a check failed.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../../src/keyframes.h"
+#include "../../src/keyframe_loader.h"
+
+// Heap allocations, counted by every replaceable global operator new: plain and array, aligned and not, throwing and
+// nothrow, along with the matching operator deletes (memory from the aligned ones has to be freed the aligned way)
+static std::atomic<size_t> allocations;
+
+static void* allocate(size_t size, size_t alignment) noexcept {
+    allocations++;
+    size = size ? size : 1;
+    if (alignment <= alignof(std::max_align_t))
+        return malloc(size);
+#ifdef _MSC_VER
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static void release(void* p, size_t alignment) noexcept {
+#ifdef _MSC_VER
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(p);
+        return;
+    }
+#endif
+    free(p);
+}
+
+static void* allocateOrThrow(size_t size, size_t alignment) {
+    if (void* p = allocate(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateOrThrow(size, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateOrThrow(size, (size_t)alignment); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, (size_t)alignment); }
+
+void operator delete(void* p) noexcept { release(p, 0); }
+void operator delete[](void* p) noexcept { release(p, 0); }
+void operator delete(void* p, size_t) noexcept { release(p, 0); }
+void operator delete[](void* p, size_t) noexcept { release(p, 0); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p, 0); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p, 0); }
+void operator delete(void* p, std::align_val_t alignment) noexcept { release(p, (size_t)alignment); }
+void operator delete[](void* p, std::align_val_t alignment) noexcept { release(p, (size_t)alignment); }
+void operator delete(void* p, size_t, std::align_val_t alignment) noexcept { release(p, (size_t)alignment); }
+void operator delete[](void* p, size_t, std::align_val_t alignment) noexcept { release(p, (size_t)alignment); }
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept { release(p, (size_t)alignment); }
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept { release(p, (size_t)alignment); }
+
+// Keys of every track, as the loader keeps them
+struct ParsedKeys {
+    std::vector<float> stamps[TRACK_COUNT];
+    std::vector<float> values[TRACK_COUNT];
+
+    void clear() {
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            stamps[k].clear();
+            values[k].clear();
+        }
+    }
+
+    bool operator==(const ParsedKeys& other) const {
+        for (int k = 0; k < TRACK_COUNT; k++)
+            if (stamps[k].size() != other.stamps[k].size() || values[k].size() != other.values[k].size() ||
+                memcmp(stamps[k].data(), other.stamps[k].data(), stamps[k].size() * sizeof(float)) ||
+                memcmp(values[k].data(), other.values[k].data(), values[k].size() * sizeof(float)))
+                return false;
+        return true;
+    }
+};
+
+// Previous path: read the file into a JSON document, and walk it
+static void readDocument(const std::string& filename, ParsedKeys& keys) {
+    std::ifstream file(filename);
+    json j;
+    file >> j;
+    readKeyframes(j["keyframes"], keys.stamps, keys.values);
+}
+
+// Memory mapped parser
+static void readMapped(const std::string& filename, ParsedKeys& keys) {
+    MappedFile file(filename.c_str());
+    KeyframeSections sections;
+    parseKeyframeFile(file.data, file.size, keys.stamps, keys.values, sections);
+}
+
+// Microseconds per call
+template<typename Function>
+static double measure(int repeats, Function function) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++)
+        function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - begin).count() / repeats;
+}
+
+// The keyframes of a file repeated one after the other, until the file is at least a number of bytes
+// Keys stay in the file's order, like the editor writes them
+static size_t writeSynthetic(const std::string& source, const std::string& filename, size_t bytes) {
+    std::ifstream input(source);
+    nlohmann::ordered_json j;
+    input >> j;
+
+    nlohmann::ordered_json frames = j["keyframes"];
+    double length = frames.back()["time"].get<double>() + 1.0;
+    size_t frameBytes = j.dump(4).size() / (frames.size() ? frames.size() : 1);
+
+    j["keyframes"] = nlohmann::ordered_json::array();
+    for (unsigned int r = 0; j["keyframes"].size() * frameBytes < bytes; r++) {
+        for (nlohmann::ordered_json frame : frames) {
+            frame["time"] = frame["time"].get<double>() + r * length;
+            for (nlohmann::ordered_json& node : frame["nodes"])
+                if (node["track"] == "timestamps")
+                    node["value"] = frame["time"];
+            j["keyframes"].push_back(frame);
+        }
+    }
+
+    std::ofstream output(filename);
+    std::string text = j.dump(4);
+    output << text;
+    return text.size();
+}
+
+// Benchmark both paths on one file, returns false if a check failed
+static bool benchFile(const std::string& name, const std::string& filename, size_t bytes) {
+    ParsedKeys document, mapped;
+    readDocument(filename, document);
+    readMapped(filename, mapped);
+
+    size_t keys = 0;
+    for (int k = 0; k < TRACK_COUNT; k++)
+        keys += mapped.stamps[k].size();
+
+    // Tables are warm (they have grown to their size), so parsing again shouldn't allocate
+    mapped.clear();
+    size_t before = allocations;
+    readMapped(filename, mapped);
+    size_t parserAllocations = allocations - before;
+
+    int repeats = bytes > (1 << 24) ? 3 : 200;
+    double documentTime = measure(repeats, [&] { document.clear(); readDocument(filename, document); });
+    double mappedTime = measure(repeats, [&] { mapped.clear(); readMapped(filename, mapped); });
+
+    bool same = document == mapped;
+    printf("%-9s %9zu bytes %8zu keys  document %10.1f us  mapped %8.1f us (%5.1fx, %4.0f MB/s)  allocations %zu  %s\n", name.c_str(), bytes, keys,
+        documentTime, mappedTime, documentTime / mappedTime, bytes / mappedTime, parserAllocations, same ? "same keys" : "KEYS DIFFER");
+
+    return same && parserAllocations == 0;
+}
+
+// Compiled tables of the last load, to compare a load from the .json file with one from the cache
+static std::vector<char> loadedTables() {
+    std::vector<char> tables;
+    auto add = [&](const void* data, size_t bytes) { tables.insert(tables.end(), (const char*)data, (const char*)data + bytes); };
+    unsigned int keys = keyframes.first[TRACK_COUNT];
+    add(keyframes.first, sizeof(keyframes.first));
+    add(keyframes.start, keys * sizeof(float));
+    add(keyframes.invDuration, keys * sizeof(float));
+    add(keyframes.segments, keys * sizeof(KeyframeSegment));
+#ifdef KEY_TICK
+    add(keyframes.startSample, keys * sizeof(unsigned int));
+#endif
+    add(speedIntegral, (keyframes.first[TRACK_SPEED + 1] - keyframes.first[TRACK_SPEED]) * sizeof(KeyframeIntegral));
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        add(liveTables->trackStamps[k].data(), liveTables->trackStamps[k].size() * sizeof(float));
+        add(liveTables->trackValues[k].data(), liveTables->trackValues[k].size() * sizeof(float));
+    }
+    return tables;
+}
+
+// Load from the .json file (writing the cache) and from the cache, returns false if they differ
+static bool benchCache(const std::string& filename) {
+    std::string cache = filename + ".cache";
+    double loadTime = measure(200, [&] { std::filesystem::remove(cache); loadKeyframesFromJSON(filename); });
+    std::vector<char> parsed = loadedTables();
+
+    double cachedTime = measure(200, [&] { loadKeyframesFromJSON(filename); });
+    bool same = loadedTables() == parsed && liveTables->cache;
+
+    printf("%-9s loadKeyframesFromJSON %.1f us (parse, compile, write cache), from the cache %.1f us (%.0fx)  %s\n", "", loadTime, cachedTime,
+        loadTime / cachedTime, same ? "same tables" : "TABLES DIFFER");
+    return same;
+}
+
+int main(int argc, char** argv) {
+    std::string filename = argc > 1 ? argv[1] : "../../assets/keyframes/keyframes.json";
+    std::string synthetic = argc > 2 ? argv[2] : "synthetic.json";
+    size_t megabytes = argc > 3 ? (size_t)atoi(argv[3]) : 50;
+
+    std::ifstream input(filename, std::ios::binary | std::ios::ate);
+    if (!input.is_open()) {
+        fprintf(stderr, "Could not open file: %s\n", filename.c_str());
+        return 1;
+    }
+    size_t bytes = (size_t)input.tellg();
+
+    bool passed = benchFile("file", filename, bytes);
+    passed = benchCache(filename) && passed;
+    size_t syntheticBytes = writeSynthetic(filename, synthetic, megabytes << 20);
+    passed = benchFile("synthetic", synthetic, syntheticBytes) && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,495 @@
+// Copyright (c) 2025 Adam Kohazi (derangedlines)
+// Licensed under the MIT License.
+
+// Keyframe reducer
+//
+// Builds on Linux (or any platform with a C++20 compiler), without Win32:
+//   g++ -std=c++20 -O2 -DDEBUG -o keyframe_reducer keyframe_reducer.cpp
+//
+// Usage:
+//   keyframe_reducer input.json output.json output.h [max error]
+//
+// Refits every track of a keyframe file with as few keys as possible, keeping its packed keys within max error
+// (0.001 by default) of the original keys packed. Kept keys are a subset of the original ones, with the
+// interpolation mode of each segment chosen from the supported modes.
+//
+// The reduced .json file can be loaded by debug builds (tracks don't need a key at every keyframe),
+// the reduced header replaces keyframe_data.h for release builds (keys of every track back to back, each
+// timed by an index into the timestamps the tracks share).
+// Clips and their instances are passed through unchanged (KEYFRAME_CLIPS in the header), and so are
+// generators (KEYFRAME_GENERATORS).
+// Bytes saved compared to the editor's keyframe table (a row for every distinct keyframe), and the change
+// in evaluation cost, are reported. Only replace the header when it is smaller.
+//
+// The keyframe editor fills in missing keys when it opens a file, so keep editing the original .json file
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../src/keyframes.h"
+#include "../../src/keyframe_loader.h"
+
+// One key of a track, as authored
+struct Key {
+    double time;
+    double value;
+    int mode; // Interpolation from the previous key
+};
+
+// Clips and generators of the input file, read like the loader does
+static KeyframeTables sourceTables;
+
+// Keys of every track from a keyframe file, following the same rules as the loader
+static bool loadTracks(const std::string& filename, std::vector<Key> (&tracks)[TRACK_COUNT], json& j) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file >> j;
+
+    for (const auto& frame : j["keyframes"]) {
+        double time = frame["time"];
+        for (const auto& node : frame["nodes"]) {
+            std::string name = node["track"];
+            int k = findTrack(name.data(), name.size());
+            if (k == TRACK_COUNT || k == TRACK_TIMESTAMPS)
+                continue;
+
+            // A repeated timestamp overrides the previous key
+            std::vector<Key>& keys = tracks[k];
+            Key key = { time, node["value"], node["mode"] };
+            if (!keys.empty() && (float)keys.back().time == (float)time)
+                keys.back() = key;
+            else
+                keys.push_back(key);
+        }
+    }
+
+    // Tracks without keys hold zero
+    for (std::vector<Key>& keys : tracks)
+        if (keys.empty())
+            keys.push_back({ 0.0, 0.0, STEP });
+
+    return true;
+}
+
+// Pack a value like the keyframe editor does for the release header
+static float packValue(double value, int mode, bool timestamp) {
+    float packed = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &packed, sizeof(bits));
+    if (timestamp) {
+        bits &= ~0xFFFu; // Mask out the last 12 bits
+    }
+    else {
+        bits &= ~0xFFFFu; // Mask out the last 16 bits
+        bits |= 0xF & mode; // Pack interpolation mode into last 4 bits
+    }
+    memcpy(&packed, &bits, sizeof(bits));
+    return packed;
+}
+
+// Key as the release build reads it back from the header: time and value packed
+static Key packedKey(const Key& key, int mode) {
+    return { packValue(key.time, STEP, true), packValue(key.value, mode, false), mode };
+}
+
+// Value of a segment between two keys, with a given interpolation mode
+static double segmentValue(const Key& a, const Key& b, int mode, double time) {
+    double t = b.time > a.time ? (time - a.time) / (b.time - a.time) : 1.0;
+    t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+
+    const float* w = interpolationWeights[mode > CUBIC_OUT ? SMOOTHSTEP : mode]; // Not for splines
+    return a.value + t * (w[0] + t * (w[1] + t * w[2])) * (b.value - a.value);
+}
+
+// Times at which a replacement segment is compared with the original keys between keys a and b:
+// every key, just before every key (to catch steps), and evenly inside every original segment
+static void sampleTimes(const std::vector<Key>& keys, size_t a, size_t b, std::vector<double>& times) {
+    times.clear();
+    for (size_t i = a; i < b; i++) {
+        double duration = keys[i + 1].time - keys[i].time;
+        for (int s = 0; s < 16; s++)
+            times.push_back(keys[i].time + duration * s / 16.0);
+        times.push_back(nextafter(keys[i + 1].time, -INFINITY));
+    }
+    times.push_back(keys[b].time);
+}
+
+// Original value of a track, evaluated in double precision
+static double originalValue(const std::vector<Key>& keys, double time) {
+    size_t i = 0;
+    while (i + 1 < keys.size() && time >= keys[i + 1].time)
+        i++;
+    return i + 1 < keys.size() ? segmentValue(keys[i], keys[i + 1], keys[i + 1].mode, time) : keys[i].value;
+}
+
+// Largest error of replacing the keys between a and b with a single segment from first to last
+// Keys are compared as the release build reads them (packed), so the header keeps the bound
+static double segmentError(const std::vector<Key>& packed, size_t a, size_t b, const Key& first, const Key& last, std::vector<double>& times) {
+    sampleTimes(packed, a, b, times);
+
+    double error = 0.0;
+    size_t i = a;
+    for (double time : times) {
+        while (i + 1 < b && time >= packed[i + 1].time)
+            i++;
+        double original = time >= packed[b].time ? packed[b].value : segmentValue(packed[i], packed[i + 1], packed[i + 1].mode, time);
+        error = std::max(error, fabs(segmentValue(first, last, last.mode, time) - original));
+    }
+    return error;
+}
+
+// Greedy refit: from each kept key, reach as far as a single segment of any mode allows
+// Spline tangents depend on the neighbouring keys, so tracks with splines are kept as they are
+static std::vector<Key> reduceTrack(const std::vector<Key>& keys, double maxError) {
+    for (size_t i = 1; i < keys.size(); i++)
+        if (keys[i].mode == SPLINE)
+            return keys;
+
+    std::vector<Key> reduced = { keys[0] };
+    std::vector<Key> packed;
+    std::vector<double> times;
+    for (const Key& key : keys)
+        packed.push_back(packedKey(key, key.mode));
+
+    size_t a = 0;
+    while (a + 1 < keys.size()) {
+        // The next key always fits, with its own mode
+        size_t best = a + 1;
+        int bestMode = keys[a + 1].mode;
+
+        for (size_t b = a + 2; b < keys.size(); b++) {
+            // Try the mode of the original key first, then all others
+            Key first = packedKey(keys[a], reduced.back().mode);
+            int fit = -1;
+            if (segmentError(packed, a, b, first, packedKey(keys[b], keys[b].mode), times) <= maxError)
+                fit = keys[b].mode;
+            for (int mode = STEP; fit < 0 && mode <= CUBIC_OUT; mode++)
+                if (segmentError(packed, a, b, first, packedKey(keys[b], mode), times) <= maxError)
+                    fit = mode;
+
+            if (fit < 0)
+                break;
+            best = b;
+            bestMode = fit;
+        }
+
+        Key key = keys[best];
+        key.mode = bestMode;
+        reduced.push_back(key);
+        a = best;
+    }
+
+    // A single key holds its value, so trailing keys with the same value aren't needed
+    while (reduced.size() > 1 && reduced[reduced.size() - 1].value == reduced[reduced.size() - 2].value)
+        reduced.pop_back();
+
+    return reduced;
+}
+
+// Float literal that reads back exactly
+static std::string floatLiteral(float value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.9g", value);
+    std::string literal = text;
+    if (literal.find_first_of(".e") == std::string::npos)
+        literal += ".0";
+    return literal + "f";
+}
+
+// Reduced keys as a keyframe file, one keyframe per distinct key time, with only the tracks keyed there
+static size_t writeJSON(const std::string& filename, const std::vector<Key> (&tracks)[TRACK_COUNT], const json& source) {
+    std::vector<double> times;
+    for (const std::vector<Key>& keys : tracks)
+        for (const Key& key : keys)
+            times.push_back(key.time);
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    json j;
+    j["time"] = source["time"];
+    j["tracks"] = source["tracks"];
+    j["keyframes"] = json::array();
+    if (source.contains("clips"))
+        j["clips"] = source["clips"];
+    if (source.contains("instances"))
+        j["instances"] = source["instances"];
+    if (source.contains("generators"))
+        j["generators"] = source["generators"];
+
+    size_t cursor[TRACK_COUNT] = {};
+    for (double time : times) {
+        json frame;
+        frame["time"] = time;
+        frame["nodes"] = json::array({ { {"track", "timestamps"}, {"value", time}, {"mode", STEP} } });
+
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            if (cursor[k] < tracks[k].size() && tracks[k][cursor[k]].time == time) {
+                const Key& key = tracks[k][cursor[k]++];
+                frame["nodes"].push_back({ {"track", trackNames[k]}, {"value", key.value}, {"mode", key.mode} });
+            }
+        }
+        j["keyframes"].push_back(frame);
+    }
+
+    std::ofstream file(filename);
+    std::string text = j.dump(4);
+    file << text;
+    return text.size();
+}
+
+// Packed timestamps of every key, each once and in order (tracks mostly share them)
+static std::vector<float> sharedTimes(const std::vector<Key> (&tracks)[TRACK_COUNT]) {
+    std::vector<float> times;
+    for (const std::vector<Key>& keys : tracks)
+        for (const Key& key : keys)
+            times.push_back(packValue(key.time, STEP, true));
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    return times;
+}
+
+// Bytes of a timestamp index, for a number of shared timestamps
+static size_t timeIndexSize(size_t timeCount) {
+    return timeCount <= 256 ? sizeof(unsigned char) : sizeof(unsigned short);
+}
+
+// Reduced keys as a release header: the shared timestamps, then keys of every track back to back
+static size_t writeHeader(const std::string& filename, const std::vector<Key> (&tracks)[TRACK_COUNT], double maxError) {
+    std::string text;
+    char line[256];
+
+    snprintf(line, sizeof(line), "// Generated by Keyframe Reducer (https://github.com/adamkohazi/demo-sk8), max error %g\n", maxError);
+    text += line;
+    text += "#ifndef KEYFRAME_DATA_H_\n#define KEYFRAME_DATA_H_\n\n";
+    text += "// Keys of every track back to back, in the order of the Track enum, timed by an index into the shared timestamps\n";
+    text += "#define SPARSE_KEYFRAMES\n\n";
+
+    text += "constexpr unsigned short trackKeyCounts[] = {";
+    for (int k = 0; k < TRACK_COUNT; k++)
+        text += (k ? ", " : " ") + std::to_string(tracks[k].size());
+    text += " };\n\n";
+
+    std::vector<float> times = sharedTimes(tracks);
+    if (times.size() > 65536) {
+        fprintf(stderr, "Too many distinct timestamps for the header: %zu\n", times.size());
+        return 0;
+    }
+
+    text += "constexpr float sharedKeyTimes[] = {\n\t";
+    for (size_t i = 0; i < times.size(); i++)
+        text += (i ? ", " : "") + floatLiteral(times[i]);
+    text += ",\n};\n\n";
+
+    text += timeIndexSize(times.size()) == 1 ? "constexpr unsigned char trackKeyTimes[] = {\n" : "constexpr unsigned short trackKeyTimes[] = {\n";
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        text += "\t// " + std::string(trackNames[k]) + "\n\t";
+        for (size_t i = 0; i < tracks[k].size(); i++) {
+            size_t index = std::lower_bound(times.begin(), times.end(), packValue(tracks[k][i].time, STEP, true)) - times.begin();
+            text += (i ? ", " : "") + std::to_string(index);
+        }
+        text += ",\n";
+    }
+    text += "};\n\n";
+
+    text += "constexpr float trackKeyValues[] = {\n";
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        text += "\t// " + std::string(trackNames[k]) + "\n\t";
+        for (size_t i = 0; i < tracks[k].size(); i++)
+            text += (i ? ", " : "") + floatLiteral(packValue(tracks[k][i].value, tracks[k][i].mode, false));
+        text += ",\n";
+    }
+    text += "};\n\n";
+
+    // Clips are kept as they are (keys of every track of every clip back to back), along with their instances
+    if (!sourceTables.clipKeyTimes.empty() && !sourceTables.clipInstanceTable.empty()) {
+        text += "// Clip library, and the instances placing it on the timeline\n";
+        text += "#define KEYFRAME_CLIPS\n\n";
+
+        text += "constexpr float clipLengths[] = {";
+        for (size_t c = 0; c < sourceTables.clipLengths.size(); c++)
+            text += (c ? ", " : " ") + floatLiteral(sourceTables.clipLengths[c]);
+        text += " };\n\n";
+
+        text += "constexpr unsigned short clipKeyCounts[][" + std::to_string(TRACK_COUNT) + "] = {\n";
+        for (size_t c = 0; c < sourceTables.clipLengths.size(); c++) {
+            text += "\t{";
+            for (int k = 0; k < TRACK_COUNT; k++)
+                text += (k ? ", " : " ") + std::to_string(sourceTables.clipKeyCounts[c * TRACK_COUNT + k]);
+            text += " },\n";
+        }
+        text += "};\n\n";
+
+        for (int array = 0; array < 2; array++) {
+            const std::vector<float>& keys = array ? sourceTables.clipKeyValues : sourceTables.clipKeyTimes;
+            text += array ? "constexpr float clipKeyValues[] = {\n\t" : "constexpr float clipKeyTimes[] = {\n\t";
+            for (size_t i = 0; i < keys.size(); i++)
+                text += (i ? ", " : "") + floatLiteral(keys[i]);
+            text += ",\n};\n\n";
+        }
+
+        text += "constexpr ClipInstance clipInstanceTable[] = {\n";
+        for (const ClipInstance& instance : sourceTables.clipInstanceTable) {
+            snprintf(line, sizeof(line), "\t{ %u, %s, %s, %s, %u },\n", instance.clip, floatLiteral(instance.start).c_str(),
+                floatLiteral(instance.scale).c_str(), floatLiteral(instance.weight).c_str(), instance.repeat);
+            text += line;
+        }
+        text += "};\n\n";
+    }
+
+    // Generators, with their tracks and inputs as indices
+    if (!sourceTables.generatorTable.empty()) {
+        text += "// Generators added to the tracks\n";
+        text += "#define KEYFRAME_GENERATORS\n\n";
+
+        text += "constexpr KeyframeGenerator generatorTable[] = {\n";
+        for (const KeyframeGenerator& generator : sourceTables.generatorTable) {
+            snprintf(line, sizeof(line), "\t{ %d, %d, %d, %s, %s, %s, %s, %s },\n", generator.track, generator.type, generator.input,
+                floatLiteral(generator.amplitude).c_str(), floatLiteral(generator.frequency).c_str(), floatLiteral(generator.phase).c_str(),
+                floatLiteral(generator.start).c_str(), floatLiteral(generator.end).c_str());
+            text += line;
+        }
+        text += "};\n\n";
+    }
+    text += "#endif //KEYFRAME_DATA_H_";
+
+    std::ofstream file(filename);
+    file << text;
+    return text.size();
+}
+
+// Timeline compiled from packed keys, like the release build does
+struct CompiledTimeline {
+    std::vector<unsigned short> counts;
+    std::vector<float> stamps, values;
+    std::vector<float> start, invDuration;
+    std::vector<KeyframeSegment> segments;
+    KeyframeTimeline<TRACK_COUNT> timeline = {};
+
+    explicit CompiledTimeline(const std::vector<Key> (&tracks)[TRACK_COUNT]) {
+        for (int k = 0; k < TRACK_COUNT; k++) {
+            counts.push_back((unsigned short)tracks[k].size());
+            for (const Key& key : tracks[k]) {
+                stamps.push_back(packValue(key.time, STEP, true));
+                values.push_back(packValue(key.value, key.mode, false));
+            }
+        }
+        start.resize(stamps.size());
+        invDuration.resize(stamps.size());
+        segments.resize(stamps.size());
+        timeline.start = start.data();
+        timeline.invDuration = invDuration.data();
+        timeline.segments = segments.data();
+        compileTracks(timeline, counts.data(), stamps.data(), values.data());
+    }
+};
+
+// Nanoseconds per cursor update and full pose, playing at 60 fps
+static double poseCost(const KeyframeTimeline<TRACK_COUNT>& timeline, double duration) {
+    const size_t frames = 1 << 18;
+    KeyframeCursor<TRACK_COUNT> cursor = {};
+    alignas(16) float pose[POSE_STRIDE];
+    volatile float sink = 0.f;
+
+    std::vector<float> times(frames);
+    for (size_t i = 0; i < frames; i++)
+        times[i] = (float)fmod(i / 60.0, duration + 1.0);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < frames; i++) {
+        updateCursor(cursor, times[i], timeline);
+        evaluatePose(cursor, timeline, pose);
+        sink = sink + pose[i % TRACK_COUNT];
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / frames;
+}
+
+// Largest difference between two sets of tracks, at 4 sub-frames per frame at 60 fps
+template<typename A, typename B>
+static double maxDifference(A a, B b, double duration) {
+    double difference = 0.0;
+    for (double time = 0.0; time < duration + 1.0; time += 1.0 / 240.0)
+        for (int k = 0; k < TRACK_COUNT; k++)
+            difference = std::max(difference, fabs(a(k, time) - b(k, time)));
+    return difference;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        fprintf(stderr, "Usage: keyframe_reducer input.json output.json output.h [max error]\n");
+        return 1;
+    }
+    const double maxError = argc > 4 ? atof(argv[4]) : 0.001;
+
+    json source;
+    std::vector<Key> original[TRACK_COUNT];
+    if (!loadTracks(argv[1], original, source)) {
+        fprintf(stderr, "Could not open file: %s\n", argv[1]);
+        return 1;
+    }
+    readClips(source, sourceTables);
+    readGenerators(source, sourceTables);
+
+    std::vector<Key> reduced[TRACK_COUNT];
+    size_t originalKeys = 0, reducedKeys = 0;
+    double duration = 0.0;
+    for (int k = 0; k < TRACK_COUNT; k++) {
+        reduced[k] = reduceTrack(original[k], maxError);
+        originalKeys += original[k].size();
+        reducedKeys += reduced[k].size();
+        duration = std::max(duration, original[k].back().time);
+        printf("%-18s %4zu -> %4zu keys\n", trackNames[k], original[k].size(), reduced[k].size());
+    }
+
+    // Sizes: files, and the keyframe data in the release executable
+    // The keyframe table has a row for every distinct timestamp (the editor pads files with repeated keyframes)
+    std::vector<float> keyframeTimes;
+    for (const auto& frame : source["keyframes"])
+        keyframeTimes.push_back(packValue(frame["time"], STEP, true));
+    std::sort(keyframeTimes.begin(), keyframeTimes.end());
+    size_t keyframeCount = std::unique(keyframeTimes.begin(), keyframeTimes.end()) - keyframeTimes.begin();
+    std::ifstream input(argv[1], std::ios::binary | std::ios::ate);
+    size_t jsonBefore = (size_t)input.tellg();
+    size_t jsonAfter = writeJSON(argv[2], reduced, source);
+    size_t headerAfter = writeHeader(argv[3], reduced, maxError);
+    if (!headerAfter)
+        return 1;
+    size_t dataBefore = sizeof(float) * keyframeCount * (1 + POSE_STRIDE);
+    size_t timeCount = sharedTimes(reduced).size();
+    size_t dataAfter = sizeof(unsigned short) * TRACK_COUNT + sizeof(float) * timeCount + (timeIndexSize(timeCount) + sizeof(float)) * reducedKeys;
+
+    // Evaluation cost, and error after packing, of the original and the reduced keys
+    CompiledTimeline before(original), after(reduced);
+    // Best of several alternating runs, so neither side pays for a cold cache or a busy machine
+    double costBefore = INFINITY, costAfter = INFINITY;
+    for (int run = 0; run < 8; run++) {
+        costBefore = std::min(costBefore, poseCost(before.timeline, duration));
+        costAfter = std::min(costAfter, poseCost(after.timeline, duration));
+    }
+
+    printf("\nKeys: %zu -> %zu\n", originalKeys, reducedKeys);
+    printf(".json file: %zu -> %zu bytes (%zu saved)\n", jsonBefore, jsonAfter, jsonBefore - jsonAfter);
+    printf("Header: %zu bytes of text\n", headerAfter);
+    printf("Release keyframe data: %zu -> %zu bytes (%lld saved)\n", dataBefore, dataAfter, (long long)dataBefore - (long long)dataAfter);
+    if (dataAfter >= dataBefore)
+        printf("The reduced header is not smaller than the keyframe table, keep the editor's header\n");
+    printf("Pose evaluation: %.1f -> %.1f ns per frame\n", costBefore, costAfter);
+    // Error of the header (the bound), compared to the original keys packed, and of the fit compared to the unpacked keys
+    double packedError = maxDifference(
+        [&](int k, double time) { return findValue((float)time, after.timeline, k); },
+        [&](int k, double time) { return findValue((float)time, before.timeline, k); }, duration);
+    double fitError = maxDifference(
+        [&](int k, double time) { return originalValue(reduced[k], time); },
+        [&](int k, double time) { return originalValue(original[k], time); }, duration);
+    printf("Max error: %g (limit %g) compared to the original keys packed, %g before packing\n", packedError, maxError, fitError);
+
+    return 0;
+}